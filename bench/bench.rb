@@ -0,0 +1,94 @@
+$LOAD_PATH.unshift(File.expand_path('../../lib', __FILE__))
+require 'fileutils'
+require 'json'
+require 'tmpdir'
+require 'xcodeproj'
+
+require File.expand_path('../generator', __FILE__)
+require File.expand_path('../suite', __FILE__)
+require File.expand_path('../comparison', __FILE__)
+
+module Xcodeproj
+  # The benchmark suite of Xcodeproj, see the `bench` Rake tasks.
+  #
+  module Bench
+    # @return [String] The default path of the results of a run.
+    #
+    DEFAULT_OUTPUT = File.expand_path('../../tmp/bench/results.json', __FILE__)
+
+    # @return [String] The default path of the baseline.
+    #
+    DEFAULT_BASELINE = File.expand_path('../baseline.json', __FILE__)
+
+    # Runs the suite with the options of the given environment and writes the
+    # results.
+    #
+    # The environment can define the scale of the generated workspace
+    # (`TARGETS`, `FILES` and `DEPTH`), the number of `ITERATIONS`, the
+    # benchmarks to run (`ONLY`, separated by commas) and the `OUTPUT` path.
+    #
+    # @param  [Hash] env
+    #         The environment.
+    #
+    # @param  [String] output
+    #         The path of the results, unless defined by the environment.
+    #
+    # @return [Hash] The results.
+    #
+    def self.run(env = ENV, output = DEFAULT_OUTPUT)
+      scale = {}
+      scale[:targets] = Integer(env['TARGETS']) if env['TARGETS']
+      scale[:files] = Integer(env['FILES']) if env['FILES']
+      scale[:depth] = Integer(env['DEPTH']) if env['DEPTH']
+      iterations = Integer(env['ITERATIONS'] || 3)
+      names = (env['ONLY'] || '').split(',').map(&:strip)
+
+      Dir.mktmpdir('xcodeproj-bench') do |dir|
+        generator = Generator.new(File.join(dir, 'Bench'), scale)
+        results = Suite.new(generator, iterations).run(names)
+        write(results, env['OUTPUT'] || output)
+        results
+      end
+    end
+
+    # Compares the given results with the baseline of the given environment,
+    # `BASELINE`, with the `TIME_TOLERANCE` and `ALLOCATIONS_TOLERANCE`
+    # relative tolerances.
+    #
+    # @param  [Hash] results
+    #         The results of a run.
+    #
+    # @param  [Hash] env
+    #         The environment.
+    #
+    # @return [Comparison] The comparison.
+    #
+    def self.compare(results, env = ENV)
+      baseline_path = env['BASELINE'] || DEFAULT_BASELINE
+      unless File.exist?(baseline_path)
+        raise Informative, "[Xcodeproj] No baseline at `#{baseline_path}`, run `rake bench:baseline` first."
+      end
+      tolerances = {}
+      tolerances[:time] = Float(env['TIME_TOLERANCE']) if env['TIME_TOLERANCE']
+      tolerances[:allocations] = Float(env['ALLOCATIONS_TOLERANCE']) if env['ALLOCATIONS_TOLERANCE']
+      Comparison.new(JSON.parse(File.read(baseline_path)), results, tolerances)
+    end
+
+    # Writes the given results as JSON.
+    #
+    # @return [void]
+    #
+    def self.write(results, path)
+      FileUtils.mkdir_p(File.dirname(path))
+      File.write(path, JSON.pretty_generate(results) + "\n")
+    end
+
+    # @return [String] A table of the given results.
+    #
+    def self.report(results)
+      results['results'].map do |name, measures|
+        "#{name.ljust(24)} time: #{measures['time']}  allocations: #{measures['allocations']}  retained: #{measures['retained']}"
+      end.join("\n")
+    end
+  end
+end
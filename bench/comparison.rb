@@ -0,0 +1,96 @@
+module Xcodeproj
+  module Bench
+    # Compares the results of a run of the {Suite} with the ones of a
+    # baseline.
+    #
+    class Comparison
+      # @return [Float] The default tolerance on the time, relative to the
+      #         baseline.
+      #
+      DEFAULT_TIME_TOLERANCE = 0.25
+
+      # @return [Float] The default tolerance on the allocated objects,
+      #         relative to the baseline.
+      #
+      DEFAULT_ALLOCATIONS_TOLERANCE = 0.10
+
+      # @return [Hash] The results of the baseline.
+      #
+      attr_reader :baseline
+
+      # @return [Hash] The results of the run.
+      #
+      attr_reader :results
+
+      # @param  [Hash] baseline
+      #         The results of the baseline.
+      #
+      # @param  [Hash] results
+      #         The results of the run.
+      #
+      # @param  [Hash] tolerances
+      #         The `:time` and the `:allocations` tolerances, relative to the
+      #         baseline.
+      #
+      def initialize(baseline, results, tolerances = {})
+        @baseline = baseline
+        @results = results
+        @time_tolerance = tolerances[:time] || DEFAULT_TIME_TOLERANCE
+        @allocations_tolerance = tolerances[:allocations] || DEFAULT_ALLOCATIONS_TOLERANCE
+        unless baseline['scale'] == results['scale']
+          raise Informative, '[Xcodeproj] The scale of the baseline ' \
+            "(#{baseline['scale']}) doesn't match the one of the run (#{results['scale']})."
+        end
+      end
+
+      # @return [Array<String>] The descriptions of the measures of the run
+      #         which exceed the ones of the baseline beyond the tolerances.
+      #
+      def regressions
+        results['results'].flat_map do |name, measures|
+          reference = baseline['results'][name]
+          next [] unless reference
+          [
+            regression(name, 'time', measures, reference, @time_tolerance),
+            regression(name, 'allocations', measures, reference, @allocations_tolerance),
+          ].compact
+        end
+      end
+
+      # @return [String] A table of the measures of the run with their
+      #         variation relative to the baseline. The retained objects are
+      #         reported but not checked, as they are close to zero for most
+      #         benchmarks.
+      #
+      def report
+        results['results'].map do |name, measures|
+          reference = baseline['results'][name] || {}
+          columns = %w(time allocations retained).map do |key|
+            "#{key}: #{measures[key]} (#{variation(measures[key], reference[key])})"
+          end
+          "#{name.ljust(24)} #{columns.join('  ')}"
+        end.join("\n")
+      end
+
+      private
+
+      # @return [String] The description of the regression of the given
+      #         measure.
+      # @return [Nil] If the measure is within the tolerance.
+      #
+      def regression(name, key, measures, reference, tolerance)
+        return unless reference[key] && measures[key] > reference[key] * (1 + tolerance)
+        "#{name} #{key}: #{measures[key]} exceeds the baseline #{reference[key]} " \
+          "by more than #{(tolerance * 100).round}% (#{variation(measures[key], reference[key])})"
+      end
+
+      # @return [String] The variation of a value relative to a reference.
+      #
+      def variation(value, reference)
+        return 'new' unless reference
+        return '=' if reference.zero?
+        format('%+.1f%%', (value - reference) * 100.0 / reference)
+      end
+    end
+  end
+end
@@ -0,0 +1,174 @@
+require 'fileutils'
+require 'xcodeproj'
+
+module Xcodeproj
+  module Bench
+    # Generates a synthetic workspace through the public API of Xcodeproj.
+    #
+    # The workspace contains a project with the given number of targets, each
+    # with its own tree of groups, source files, xcconfig files which include
+    # a shared one and a shared scheme.
+    #
+    class Generator
+      # @return [Hash] The default scale of the generated projects.
+      #
+      DEFAULT_SCALE = {
+        :targets => 50,
+        :files => 40,
+        :depth => 4,
+      }.freeze
+
+      # @return [String] The name of the generated project and workspace.
+      #
+      NAME = 'Bench'.freeze
+
+      # @return [Pathname] The directory where the workspace is generated.
+      #
+      attr_reader :root
+
+      # @return [Hash] The scale of the generated project, see
+      #         {DEFAULT_SCALE}.
+      #
+      attr_reader :scale
+
+      # @param  [#to_s] root
+      #         The directory where the workspace is generated.
+      #
+      # @param  [Hash] scale
+      #         The number of `:targets`, the number of `:files` per target
+      #         and the `:depth` of the groups of each target.
+      #
+      def initialize(root, scale = {})
+        @root = Pathname.new(root.to_s).expand_path
+        @scale = DEFAULT_SCALE.merge(scale)
+      end
+
+      # @return [Pathname] The path of the generated project.
+      #
+      def project_path
+        root + "#{NAME}.xcodeproj"
+      end
+
+      # @return [Pathname] The path of the generated workspace.
+      #
+      def workspace_path
+        root + "#{NAME}.xcworkspace"
+      end
+
+      # @return [Pathname] The directory of the generated xcconfig files.
+      #
+      def configs_dir
+        root + 'Configs'
+      end
+
+      # @return [Pathname] The path of the large `project.pbxproj` file
+      #         generated by {#generate_large_pbxproj}.
+      #
+      def large_pbxproj_path
+        root + 'Large.pbxproj'
+      end
+
+      # Generates the workspace, replacing any previous one.
+      #
+      # @return [void]
+      #
+      def generate
+        FileUtils.rm_rf(root)
+        FileUtils.mkdir_p(configs_dir)
+        File.write(configs_dir + 'Shared.xcconfig', shared_xcconfig)
+
+        project = Project.new(project_path, false, Constants::LAST_KNOWN_OBJECT_VERSION, :uuid_seed => NAME)
+        library = project.new_target(:static_library, 'Shared', :ios, '12.0')
+        scale[:targets].times do |index|
+          add_target(project, library, index)
+        end
+        project.save
+
+        project.targets.each do |target|
+          scheme = XCScheme.new
+          scheme.configure_with_targets(target, nil, :launch_target => target.launchable_target_type?)
+          scheme.save_as(project_path, target.name)
+        end
+
+        workspace = Workspace.new(nil, Workspace::FileReference.new("#{NAME}.xcodeproj"))
+        workspace.save_as(workspace_path)
+      end
+
+      # Generates a large `project.pbxproj` file, whose objects section
+      # repeats the one of the generated project. Every hundred lines of the
+      # copies are followed by the separator marker of a merge conflict,
+      # which is opened before them but never closed, the worst case for
+      # detecting a conflict.
+      #
+      # @param  [Integer] size
+      #         The minimum size of the file in bytes.
+      #
+      # @return [void]
+      #
+      def generate_large_pbxproj(size)
+        contents = File.read(project_path + 'project.pbxproj')
+        head, objects, tail = contents.partition(/^\tobjects = \{\n.*?^\t\};\n/m)
+        chunk = objects.lines.each_slice(100).map { |lines| lines.join << "=======\n" }.join
+        File.open(large_pbxproj_path, 'w') do |file|
+          file << head << "<<<<<<< HEAD\n"
+          written = head.bytesize
+          while written < size
+            file << chunk
+            written += chunk.bytesize
+          end
+          file << tail
+        end
+      end
+
+      private
+
+      # @!group Private helpers
+      #-----------------------------------------------------------------------#
+
+      # Adds a target with its groups, files and xcconfig files.
+      #
+      # @return [void]
+      #
+      def add_target(project, library, index)
+        name = format('Target%04d', index)
+        type = index.even? ? :application : :framework
+        target = project.new_target(type, name, :ios, '12.0')
+        target.add_dependency(library)
+
+        group = project.main_group.new_group(name, name)
+        scale[:depth].times { |level| group = group.new_group("Level#{level}", "Level#{level}") }
+        references = Array.new(scale[:files]) do |file_index|
+          extension = file_index.even? ? 'm' : 'swift'
+          group.new_reference("#{name}File#{file_index}.#{extension}")
+        end
+        target.add_file_references(references, '-DBENCH=1')
+
+        target.build_configurations.each do |configuration|
+          config_path = configs_dir + "#{name}.#{configuration.name}.xcconfig"
+          File.write(config_path, target_xcconfig(name, configuration.name))
+          configuration.base_configuration_reference = project.new_file(config_path)
+          configuration.build_settings['OTHER_LDFLAGS'] = ['$(inherited)', '-ObjC', "-l#{name}"]
+        end
+      end
+
+      # @return [String] The xcconfig included by the ones of the targets.
+      #
+      def shared_xcconfig
+        settings = (0...50).map { |index| "SHARED_SETTING_#{index} = value_#{index} $(inherited)" }
+        (settings + ['OTHER_LDFLAGS = $(inherited) -framework Foundation', 'GCC_PREPROCESSOR_DEFINITIONS = $(inherited) SHARED=1']).join("\n") + "\n"
+      end
+
+      # @return [String] The xcconfig of a configuration of a target.
+      #
+      def target_xcconfig(name, configuration_name)
+        <<-XCCONFIG.gsub(/^ {10}/, '')
+          #include "Shared.xcconfig"
+          PRODUCT_NAME = #{name}
+          OTHER_LDFLAGS = $(inherited) -framework UIKit -l"z"
+          GCC_PREPROCESSOR_DEFINITIONS = $(inherited) #{configuration_name.upcase}=1 TARGET=#{name}
+          HEADER_SEARCH_PATHS = $(inherited) "$(PODS_ROOT)/Headers/#{name}"
+        XCCONFIG
+      end
+    end
+  end
+end
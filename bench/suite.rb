@@ -0,0 +1,301 @@
+require 'json'
+require 'tmpdir'
+require 'xcodeproj'
+
+require File.expand_path('../generator', __FILE__)
+
+module Xcodeproj
+  module Bench
+    # Times the main operations of Xcodeproj on a generated workspace and
+    # counts the objects they allocate and retain.
+    #
+    # Each benchmark has a setup, which is not measured, and a measured block
+    # which receives the value returned by the setup. The objects retained by
+    # a benchmark are the ones it allocated which are still alive, through
+    # its input or the value returned by its block, once it has run. Every
+    # benchmark is run the given number of iterations and the median of the
+    # measures is reported.
+    #
+    class Suite
+      # @return [Struct] A benchmark of the suite.
+      #
+      Benchmark = Struct.new(:name, :setup, :block)
+
+      # @return [Generator] The generator of the measured workspace.
+      #
+      attr_reader :generator
+
+      # @return [Integer] The number of times each benchmark is run.
+      #
+      attr_reader :iterations
+
+      # @param  [Generator] generator
+      #         The generator of the measured workspace.
+      #
+      # @param  [Integer] iterations
+      #         The number of times each benchmark is run.
+      #
+      def initialize(generator, iterations = 3)
+        @generator = generator
+        @iterations = iterations
+        @benchmarks = []
+        define_benchmarks
+      end
+
+      # @return [Array<String>] The names of the benchmarks.
+      #
+      def benchmark_names
+        @benchmarks.map(&:name)
+      end
+
+      # Generates the workspace and runs the benchmarks.
+      #
+      # @param  [Array<String>] names
+      #         The names of the benchmarks to run, all of them if empty.
+      #
+      # @return [Hash] The results, which can be serialized to JSON.
+      #
+      def run(names = [])
+        generator.generate
+        benchmarks = @benchmarks.select { |benchmark| names.empty? || names.include?(benchmark.name) }
+        {
+          'version' => VERSION,
+          'ruby' => RUBY_DESCRIPTION,
+          'scale' => Hash[generator.scale.map { |key, value| [key.to_s, value] }],
+          'iterations' => iterations,
+          'results' => Hash[benchmarks.map { |benchmark| [benchmark.name, measure(benchmark)] }],
+        }
+      end
+
+      private
+
+      # @!group Benchmarks
+      #-----------------------------------------------------------------------#
+
+      # Defines a benchmark.
+      #
+      # @param  [String] name
+      #         The name of the benchmark.
+      #
+      # @param  [Proc] setup
+      #         The preparation of each run, which is not measured.
+      #
+      # @return [void]
+      #
+      def benchmark(name, setup = -> {}, &block)
+        @benchmarks << Benchmark.new(name, setup, block)
+      end
+
+      # Defines the benchmarks of the suite.
+      #
+      # @return [void]
+      #
+      def define_benchmarks
+        project_path = generator.project_path
+
+        benchmark('project_open') do
+          Project.open(project_path)
+        end
+
+        snapshot_dir = generator.root + 'Snapshots'
+        snapshot_setup = -> { Project::SnapshotCache.new(snapshot_dir).fetch(project_path + 'project.pbxproj') }
+        benchmark('project_open_snapshot', snapshot_setup) do
+          Project.open(project_path, :snapshot_cache => snapshot_dir)
+        end
+
+        benchmark('project_save', -> { Project.open(project_path) }) do |project|
+          project.save
+        end
+
+        save_path = generator.root + 'Saved.xcodeproj'
+        save_setup = lambda do
+          FileUtils.rm_rf(save_path)
+          Project.open(project_path)
+        end
+        benchmark('project_save_write', save_setup) do |project|
+          project.save(save_path)
+        end
+
+        [1, 100, 1000].each do |count|
+          modified_setup = lambda do
+            project = save_setup.call
+            project.save(save_path)
+            project.files.first(count).each { |file| file.name = "Renamed#{file.display_name}" }
+            project.build_configurations.first.build_settings['GCC_PREPROCESSOR_DEFINITIONS'] = 'BENCH=1'
+            project
+          end
+          benchmark("project_save_modified_#{count}", modified_setup) do |project|
+            project.save(save_path)
+          end
+        end
+
+        benchmark('project_sort', -> { Project.open(project_path) }) do |project|
+          project.sort
+        end
+
+        sort_setup = lambda do
+          project = Project.open(project_path)
+          project.sort
+          project.files.each_with_index { |file, index| file.name = "Renamed#{file.display_name}" if (index % 50).zero? }
+          project
+        end
+        benchmark('project_sort_incremental', sort_setup) do |project|
+          project.sort(:incremental => true)
+        end
+
+        add_files = lambda do |project|
+          group = project.main_group.new_group('Added', 'Added')
+          target = project.native_targets.first
+          1000.times { |index| target.add_file_references([group.new_file("Added#{index}.m")]) }
+        end
+        benchmark('add_files', -> { Project.open(project_path) }) do |project|
+          add_files.call(project)
+        end
+
+        benchmark('add_files_transaction', -> { Project.open(project_path) }) do |project|
+          project.transaction { add_files.call(project) }
+        end
+
+        benchmark('add_files_bulk', -> { Project.open(project_path) }) do |project|
+          project.native_targets.first.add_files(Array.new(1000) { |index| "Added/Added#{index}.m" })
+        end
+
+        save_forks = lambda do |project|
+          Array.new(5) do |index|
+            fork = project.fork(generator.root + "Fork#{index}.xcodeproj")
+            fork.build_configurations.each { |configuration| configuration.build_settings['VARIANT'] = index.to_s }
+            fork.save
+            fork
+          end
+        end
+        benchmark('project_fork', -> { Project.open(project_path) }, &save_forks)
+        benchmark('project_fork_lazy', -> { Project.open(project_path, :lazy => true) }, &save_forks)
+        benchmark('project_open_copies') do
+          Array.new(5) { Project.open(project_path) }
+        end
+
+        benchmark('project_eql', -> { [Project.open(project_path), Project.open(project_path)] }) do |projects|
+          projects.first.eql?(projects.last)
+        end
+
+        digest_setup = lambda do
+          project = Project.open(project_path)
+          project.digest
+          project
+        end
+        benchmark('project_digest_incremental', digest_setup) do |project|
+          project.files.each_with_index { |file, index| file.name = "Renamed#{file.display_name}" if (index % 50).zero? }
+          project.digest
+        end
+
+        benchmark('predictabilize_uuids', -> { Project.open(project_path) }) do |project|
+          project.predictabilize_uuids
+        end
+
+        benchmark('file_real_paths', -> { Project.open(project_path) }) do |project|
+          project.files.each(&:real_path)
+        end
+
+        benchmark('resolved_build_setting', -> { Project.open(project_path) }) do |project|
+          project.native_targets.each do |target|
+            target.resolved_build_setting('OTHER_LDFLAGS', true)
+            target.resolved_build_setting('GCC_PREPROCESSOR_DEFINITIONS', true)
+          end
+        end
+
+        config_paths = -> { Dir[generator.configs_dir + '*.xcconfig'].sort }
+        benchmark('config_merge', -> { Config.clear_cache }) do
+          config = Config.new
+          config_paths.call.each { |path| config.merge!(Config.new(path)) }
+        end
+
+        diff_setup = lambda do
+          other = Project.open(project_path)
+          other.files.each_with_index { |file, index| file.path = "Renamed#{file.path}" if (index % 10).zero? }
+          [Project.open(project_path), other]
+        end
+        benchmark('project_diff', diff_setup) do |projects|
+          Differ.project_diff(*projects)
+        end
+
+        benchmark('workspace_schemes') do
+          workspace = Workspace.new_from_xcworkspace(generator.workspace_path.to_s)
+          workspace.schemes.each do |name, path|
+            next if path == workspace.path
+            XCScheme.new(File.join(path, 'xcshareddata', 'xcschemes', "#{name}.xcscheme"))
+          end
+        end
+
+        large_pbxproj = nil
+        large_pbxproj_setup = lambda do
+          large_pbxproj ||= begin
+            generator.generate_large_pbxproj(100 * 1024 * 1024)
+            Plist.read_contents(generator.large_pbxproj_path)
+          end
+        end
+        benchmark('plist_conflict_check', large_pbxproj_setup) do |contents|
+          Plist.file_in_conflict?(contents)
+        end
+      end
+
+      # @!group Measures
+      #-----------------------------------------------------------------------#
+
+      # @return [Hash] The median of the time, of the allocated objects and
+      #         of the retained objects of the runs of the given benchmark.
+      #
+      def measure(benchmark)
+        measures = Array.new(iterations) { measure_run(benchmark) }
+        {
+          'time' => median(measures.map { |measure| measure[0] }).round(6),
+          'allocations' => median(measures.map { |measure| measure[1] }),
+          'retained' => median(measures.map { |measure| measure[2] }),
+        }
+      end
+
+      # @return [Array<Numeric>] The time, the allocated objects and the
+      #         retained objects of a run of the given benchmark.
+      #
+      def measure_run(benchmark)
+        input = benchmark.setup.call
+        GC.start
+        live = live_objects
+        allocated = GC.stat(:total_allocated_objects)
+        start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        output = benchmark.block.call(input)
+        time = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+        allocations = GC.stat(:total_allocated_objects) - allocated
+        [time, allocations, retained_objects(live, output)]
+      end
+
+      # @return [Hash{Object => Boolean}] The objects which are alive.
+      #
+      def live_objects
+        ObjectSpace.each_object.each_with_object({}.compare_by_identity) { |object, objects| objects[object] = true }
+      end
+
+      # @param  [Hash{Object => Boolean}] live
+      #         The objects which were alive before the benchmark has run.
+      #
+      # @param  [Object] _output
+      #         The value returned by the block of the benchmark, which must
+      #         be alive while the objects are counted.
+      #
+      # @return [Integer] The number of objects allocated by the benchmark
+      #         which are still alive. The objects are compared rather than
+      #         counted, as the garbage of a previous run might still be
+      #         referenced from the stack when the live objects are recorded.
+      #
+      def retained_objects(live, _output)
+        GC.start
+        ObjectSpace.each_object.count { |object| !live.key?(object) }
+      end
+
+      # @return [Numeric] The median of the given values.
+      #
+      def median(values)
+        values.sort[values.count / 2]
+      end
+    end
+  end
+end
@@ -21,6 +21,7 @@ module Xcodeproj
   autoload :Constants,        'xcodeproj/constants'
   autoload :Differ,           'xcodeproj/differ'
   autoload :Helper,           'xcodeproj/helper'
+  autoload :Instrumentation,  'xcodeproj/instrumentation'
   autoload :Plist,            'xcodeproj/plist'
   autoload :Project,          'xcodeproj/project'
   autoload :Workspace,        'xcodeproj/workspace'
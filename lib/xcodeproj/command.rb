@@ -15,6 +15,11 @@ module Xcodeproj
     self.description = 'Xcodeproj lets you create and modify Xcode projects from Ruby.'
     self.plugin_prefixes = %w(claide xcodeproj)
 
+    # @return [Array<String>] The option of the commands which can print the
+    #         phases of their run.
+    #
+    PROFILE_OPTION = ['--profile', 'Print the duration, the allocations and the objects of each phase to the standard error'].freeze
+
     def initialize(argv)
       super
       unless self.ansi_output?
@@ -25,6 +30,23 @@ module Xcodeproj
 
     private
 
+    # Starts collecting the phases of the run if the `--profile` option is
+    # given.
+    #
+    def start_profile(argv)
+      return unless argv.flag?('profile')
+      @profiler = Instrumentation::Profiler.new
+      @profiler.start
+    end
+
+    # Prints the phases of the run if they have been collected.
+    #
+    def print_profile
+      return unless @profiler
+      @profiler.stop
+      UI.warn "\n#{@profiler.report}"
+    end
+
     def xcodeproj_path
       unless @xcodeproj_path
         projects = Dir.glob('*.xcodeproj')
@@ -22,10 +22,16 @@ module Xcodeproj
         CLAide::Argument.new('OUTPUT', false),
       ]
 
+      def self.options
+        [
+          PROFILE_OPTION,
+        ].concat(super)
+      end
+
       def initialize(argv)
         self.xcodeproj_path = argv.shift_argument
         @output_path = Pathname(argv.shift_argument || '.')
-
+        start_profile(argv)
         super
       end
 
@@ -42,9 +48,17 @@ module Xcodeproj
         xcodeproj.targets.each do |target|
           dump_all_configs(target, target.name)
         end
+      ensure
+        print_profile
       end
 
       def dump_all_configs(configurable, name)
+        Instrumentation.instrument('config_dump.dump', configurable) do
+          dump_configs(configurable, name)
+        end
+      end
+
+      def dump_configs(configurable, name)
         path = Pathname(name)
 
         # Dump base configuration to file
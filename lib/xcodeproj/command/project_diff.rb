@@ -14,6 +14,7 @@ module Xcodeproj
       def self.options
         [
           ['--ignore=KEY', 'A key to ignore in the comparison. Can be specified multiple times.'],
+          PROFILE_OPTION,
         ].concat(super)
       end
 
@@ -26,6 +27,7 @@ module Xcodeproj
         @path_project1  = argv.shift_argument
         @path_project2  = argv.shift_argument
         @keys_to_ignore = argv.all_options('ignore')
+        start_profile(argv)
         super
       end
 
@@ -35,14 +37,7 @@ module Xcodeproj
       end
 
       def run
-        hash_1 = @project1.to_tree_hash.dup
-        hash_2 = @project2.to_tree_hash.dup
-        @keys_to_ignore.each do |key|
-          Differ.clean_hash!(hash_1, key)
-          Differ.clean_hash!(hash_2, key)
-        end
-
-        diff = Differ.project_diff(hash_1, hash_2, @path_project1, @path_project2)
+        diff = Differ.project_diff(@project1, @project2, @path_project1, @path_project2, @keys_to_ignore)
 
         require 'yaml'
         yaml = diff.to_yaml
@@ -50,6 +45,8 @@ module Xcodeproj
         yaml.gsub!(@path_project2, @path_project2.magenta)
         yaml.gsub!(':diff:', 'diff:'.yellow)
         puts yaml
+      ensure
+        print_profile
       end
     end
   end
@@ -6,6 +6,7 @@ module Xcodeproj
       def self.options
         [
           ['--format=[hash|tree_hash|raw]', 'YAML output format'],
+          PROFILE_OPTION,
         ].concat(super)
       end
 
@@ -17,6 +18,7 @@ module Xcodeproj
         self.xcodeproj_path = argv.shift_argument
         @output_format = argv.option('format')
         @output_format &&= @output_format.to_sym
+        start_profile(argv)
         super
       end
 
@@ -54,6 +56,8 @@ module Xcodeproj
           sections << yaml
         end
         puts sections * "\n\n"
+      ensure
+        print_profile
       end
     end
   end
@@ -12,6 +12,7 @@ module Xcodeproj
       def self.options
         [
           ['--group-option=[above|below]', 'The position of the groups when sorting. If no option is specified, sorting will interleave groups and files.'],
+          PROFILE_OPTION,
         ].concat(super)
       end
 
@@ -23,6 +24,7 @@ module Xcodeproj
         self.xcodeproj_path = argv.shift_argument
         @group_option = argv.option('group-option')
         @group_option &&= @group_option.to_sym
+        start_profile(argv)
         super
       end
 
@@ -38,6 +40,8 @@ module Xcodeproj
         xcodeproj.sort(:groups_position => @group_option)
         xcodeproj.save
         puts "The `#{File.basename(xcodeproj_path)}` project was sorted"
+      ensure
+        print_profile
       end
     end
   end
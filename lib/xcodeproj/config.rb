@@ -1,5 +1,6 @@
 # frozen_string_literal: true
 require 'shellwords'
+require 'xcodeproj/config/file_cache'
 require 'xcodeproj/config/other_linker_flags_parser'
 
 module Xcodeproj
@@ -57,6 +58,7 @@ module Xcodeproj
     #
     def initialize(xcconfig_hash_or_file = {})
       @attributes = {}
+      @attribute_tokens = {}
       @includes = []
       @other_linker_flags = {}
       [:simple, :frameworks, :weak_frameworks, :libraries, :arg_files, :force_load].each do |key|
@@ -75,6 +77,36 @@ module Xcodeproj
 
     public
 
+    # @!group Cache
+    #-------------------------------------------------------------------------#
+
+    # @return [FileCache] The cache of the configuration files parsed by the
+    #         process, shared by all the instances initialized from a path.
+    #
+    # @visibility private
+    #
+    def self.file_cache
+      @file_cache ||= FileCache.new
+    end
+
+    # @return [Hash{Symbol => Integer}] The number of the lookups of
+    #         configuration files answered by the cache (`:hits`) and of the
+    #         ones which required to read the file (`:misses`).
+    #
+    def self.cache_statistics
+      { :hits => file_cache.hits, :misses => file_cache.misses }
+    end
+
+    # Discards the parsed configuration files and resets the statistics.
+    #
+    # @return [void]
+    #
+    def self.clear_cache
+      file_cache.clear
+    end
+
+    public
+
     # @!group Serialization
     #-------------------------------------------------------------------------#
 
@@ -108,6 +140,7 @@ module Xcodeproj
       end
 
       pathname.open('w') { |file| file << to_s(prefix) }
+      Config.file_cache.invalidate(pathname)
     end
 
     # The hash representation of the xcconfig. The hash includes the
@@ -146,7 +179,7 @@ module Xcodeproj
       result = @includes.map do |incl|
         path = File.expand_path(incl, @filepath.dirname)
         if File.readable? path
-          Xcodeproj::Config.new(path).to_hash
+          Config.file_cache.resolved_hash(path) { Xcodeproj::Config.new(path).to_hash }
         else
           {}
         end
@@ -215,7 +248,7 @@ module Xcodeproj
     #
     def merge!(xcconfig)
       if xcconfig.is_a? Config
-        merge_attributes!(xcconfig.attributes)
+        merge_attributes!(xcconfig.attributes, xcconfig)
         other_linker_flags.keys.each do |key|
           other_linker_flags[key].merge(xcconfig.other_linker_flags[key])
         end
@@ -246,11 +279,49 @@ module Xcodeproj
     # @return [Config] A copy of the receiver.
     #
     def dup
-      Xcodeproj::Config.new(to_hash.dup)
+      unless (@filepath.nil? || @includes.empty?) && !attributes.key?('OTHER_LDFLAGS')
+        return Xcodeproj::Config.new(to_hash.dup)
+      end
+
+      Xcodeproj::Config.new.tap do |copy|
+        attributes.each do |key, value|
+          copy.attributes[key] = value.dup unless INHERITED.any? { |i| i == value.to_s.strip }
+        end
+        other_linker_flags.each { |key, flags| copy.other_linker_flags[key].merge(flags) }
+        copy.attribute_tokens.merge!(attribute_tokens)
+      end
     end
 
     #-------------------------------------------------------------------------#
 
+    protected
+
+    # @return [Hash{String => Array(String, Array<String>)}] The value of the
+    #         attributes whose tokens have been computed while merging, with
+    #         their tokens, so that the values don't need to be split again
+    #         by the following merges. An entry is used only if the attribute
+    #         still has the same value.
+    #
+    attr_reader :attribute_tokens
+
+    # @param  [String] key
+    #         The name of the attribute.
+    #
+    # @param  [String] value
+    #         The stripped value of the attribute.
+    #
+    # @return [Array<String>] The shell tokens of the given value of an
+    #         attribute.
+    #
+    def tokens_for(key, value)
+      entry = @attribute_tokens[key]
+      if entry && entry.first == value
+        entry.last
+      else
+        value.shellsplit
+      end
+    end
+
     private
 
     # @!group Private Helpers
@@ -264,7 +335,15 @@ module Xcodeproj
     #
     def extract_hash(argument)
       return argument if argument.is_a?(Hash)
-      if argument.respond_to? :read
+      if (argument.is_a?(String) || argument.is_a?(Pathname)) && File.readable?(argument.to_s)
+        @filepath = Pathname.new(argument.to_s)
+        hash, includes = Config.file_cache.parse(@filepath) do |contents|
+          parsed_includes = []
+          [hash_from_file_content(contents, parsed_includes), parsed_includes]
+        end
+        @includes.concat(includes)
+        hash
+      elsif argument.respond_to? :read
         @filepath = Pathname.new(argument.to_path)
         hash_from_file_content(argument.read)
       elsif File.readable?(argument.to_s)
@@ -280,14 +359,17 @@ module Xcodeproj
     # @param  [String] string
     #         The string representation of an xcconfig file.
     #
+    # @param  [Array<String>] includes
+    #         The list where the included files should be added.
+    #
     # @return [Hash] the hash containing the xcconfig data.
     #
-    def hash_from_file_content(string)
+    def hash_from_file_content(string, includes = @includes)
       hash = {}
       string.split("\n").each do |line|
         uncommented_line = strip_comment(line)
         if include = extract_include(uncommented_line)
-          @includes.push normalized_xcconfig_path(include)
+          includes.push normalized_xcconfig_path(include)
         else
           key, value = extract_key_value(uncommented_line)
           next unless key
@@ -300,27 +382,47 @@ module Xcodeproj
 
     # Merges the given attributes hash while ensuring values are not duplicated.
     #
+    # The tokens of the merged values are kept, so merging many
+    # configurations with the same keys (e.g. `HEADER_SEARCH_PATHS`) splits
+    # each value only once.
+    #
     # @param  [Hash] attributes
     #         The attributes hash to merge into @attributes.
     #
+    # @param  [Config] source
+    #         The configuration which owns the attributes, if any, whose
+    #         tokens can be reused.
+    #
     # @return [void]
     #
-    def merge_attributes!(attributes)
-      @attributes.merge!(attributes) do |_, v1, v2|
+    def merge_attributes!(attributes, source = nil)
+      @attributes.merge!(attributes) do |key, v1, v2|
         v1 = v1.strip
         v2 = v2.strip
-        v1_split = v1.shellsplit
-        v2_split = v2.shellsplit
+        v1_split = tokens_for(key, v1)
+        v2_split = source ? source.tokens_for(key, v2) : v2.shellsplit
         if (v2_split - v1_split).empty? || v1_split.first(v2_split.size) == v2_split
-          v1
+          store_tokens(key, v1, v1_split)
         elsif v2_split.first(v1_split.size) == v1_split
-          v2
+          store_tokens(key, v2, v2_split)
         else
-          "#{v1} #{v2}"
+          value = "#{v1} #{v2}"
+          # A trailing backslash would escape the separator.
+          store_tokens(key, value, v1_split + v2_split) unless v1.end_with?('\\')
+          value
         end
       end
     end
 
+    # Stores the tokens of the value of an attribute.
+    #
+    # @return [String] the value.
+    #
+    def store_tokens(key, value, tokens)
+      @attribute_tokens[key] = [value.dup.freeze, tokens.freeze]
+      value
+    end
+
     # Strips the comments from a line of an xcconfig string.
     #
     # @param  [String] line
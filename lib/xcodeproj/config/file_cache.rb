@@ -0,0 +1,162 @@
+require 'monitor'
+
+module Xcodeproj
+  class Config
+    # Caches the configuration files parsed by the process, so that a file
+    # shared by many build configurations or projects, or included by many
+    # other files, is read and parsed only once.
+    #
+    # The entries are keyed by the expanded path of the files and are
+    # discarded when the modification date or the size of the files change.
+    # Besides the contents of each file, the cache keeps the resolved hash of
+    # the files included by other ones, which depends on the whole graph of
+    # their includes.
+    #
+    # @note   Clients are not expected to use this class directly, see
+    #         {Config.cache_statistics} and {Config.clear_cache}.
+    #
+    class FileCache
+      # @visibility private
+      #
+      Entry = Struct.new(:stamp, :hash, :includes, :resolved_hash, :resolved_stamps)
+
+      # @return [Integer] the number of lookups answered by the cache.
+      #
+      attr_reader :hits
+
+      # @return [Integer] the number of lookups which required to read a
+      #         file.
+      #
+      attr_reader :misses
+
+      def initialize
+        @monitor = Monitor.new
+        clear
+      end
+
+      # Returns the contents of the configuration file at the given path,
+      # parsing it if it is not cached or if it changed.
+      #
+      # @param  [Pathname, String] path
+      #         The path of the configuration file.
+      #
+      # @yield  [String] the contents of the file, to parse when the file is
+      #         not cached.
+      #
+      # @yieldreturn [Array(Hash, Array<String>)] the settings and the
+      #         includes of the file.
+      #
+      # @return [Array(Hash, Array<String>)] a copy of the settings and of the
+      #         includes of the file.
+      #
+      def parse(path, &parser)
+        path = File.expand_path(path.to_s)
+        @monitor.synchronize do
+          entry = entry_for(path, &parser)
+          [copy(entry.hash), entry.includes.dup]
+        end
+      end
+
+      # Returns the hash representation of the configuration file at the
+      # given path, including the settings of the files it includes.
+      #
+      # @param  [Pathname, String] path
+      #         The path of the configuration file.
+      #
+      # @yieldreturn [Hash] the hash representation of the file, to compute
+      #         when it is not cached or when the file, or any of the files
+      #         it includes, changed.
+      #
+      # @return [Hash] a copy of the hash representation.
+      #
+      def resolved_hash(path)
+        path = File.expand_path(path.to_s)
+        @monitor.synchronize do
+          entry = @entries[path]
+          if entry && entry.resolved_stamps && entry.resolved_stamps.all? { |p, s| stamp(p) == s }
+            @hits += 1
+            return copy(entry.resolved_hash)
+          end
+
+          hash = yield
+          return hash unless entry = @entries[path]
+          stamps = { path => entry.stamp }
+          entry.includes.each do |include|
+            include_path = File.expand_path(include, File.dirname(path))
+            include_entry = @entries[include_path]
+            if include_entry && include_entry.resolved_stamps
+              stamps.merge!(include_entry.resolved_stamps)
+            else
+              stamps[include_path] = stamp(include_path)
+            end
+          end
+          entry.resolved_hash = copy(hash)
+          entry.resolved_stamps = stamps
+          hash
+        end
+      end
+
+      # Discards the entry of the given file, which is useful when the file
+      # is modified without changing its size within the resolution of the
+      # modification dates of the file system.
+      #
+      # @param  [Pathname, String] path
+      #         The path of the configuration file.
+      #
+      # @return [void]
+      #
+      def invalidate(path)
+        @monitor.synchronize { @entries.delete(File.expand_path(path.to_s)) }
+      end
+
+      # Discards all the entries and resets the statistics.
+      #
+      # @return [void]
+      #
+      def clear
+        @monitor.synchronize do
+          @entries = {}
+          @hits = 0
+          @misses = 0
+        end
+      end
+
+      private
+
+      # @!group Private helpers
+      #-----------------------------------------------------------------------#
+
+      # @return [Entry] the up to date entry of the given file.
+      #
+      def entry_for(path)
+        stamp = stamp(path)
+        entry = @entries[path]
+        if entry && entry.stamp == stamp
+          @hits += 1
+          return entry
+        end
+
+        @misses += 1
+        hash, includes = yield File.read(path)
+        @entries[path] = Entry.new(stamp, copy(hash), includes.dup.freeze)
+      end
+
+      # @return [Array] the modification date and the size of the given file.
+      # @return [Nil] if the file doesn't exist.
+      #
+      def stamp(path)
+        stat = File.stat(path)
+        [stat.mtime, stat.size]
+      rescue SystemCallError
+        nil
+      end
+
+      # @return [Hash] a copy of the given settings which can be modified
+      #         without affecting the cache.
+      #
+      def copy(hash)
+        hash.each_with_object({}) { |(key, value), copy| copy[key] = value.dup }
+      end
+    end
+  end
+end
@@ -462,6 +462,28 @@ module Xcodeproj
     #
     HEADER_FILES_EXTENSIONS = %w(.h .hh .hpp .ipp .tpp .hxx .def .inl .inc).freeze
 
+    # @return [Array] The extensions which are associated with files compiled
+    #                 by the sources build phase.
+    #
+    SOURCE_FILES_EXTENSIONS = %w(
+      .c .c++ .cc .cpp .cxx .docc .intentdefinition .l .lm .m .metal .mlmodel
+      .mlpackage .mm .s .swift .xcdatamodeld .xcmappingmodel .y .ym
+    ).freeze
+
+    # @return [Array] The extensions which are associated with the libraries
+    #                 and frameworks linked by the frameworks build phase.
+    #
+    FRAMEWORK_FILES_EXTENSIONS = %w(.a .dylib .framework .so .tbd .xcframework).freeze
+
+    # @return [Array] The extensions which are associated with files copied by
+    #                 the resources build phase, rather than compiled.
+    #
+    RESOURCE_FILES_EXTENSIONS = %w(
+      .bundle .caf .gif .html .jpeg .jpg .json .lproj .m4a .mov .mp3 .mp4 .otf
+      .pdf .png .scnassets .sks .storyboard .strings .stringsdict .ttf .wav
+      .xcassets .xcstrings .xib
+    ).freeze
+
     # @return [Array] The keywords Xcode use to identify a build setting can
     #                 inherit values from a previous precedence level
     INHERITED_KEYWORDS = %w(
@@ -469,6 +491,10 @@ module Xcodeproj
       ${inherited}
     ).freeze
 
+    # @return [Regexp] The regular expression which matches any of the
+    #                  {INHERITED_KEYWORDS}.
+    INHERITED_KEYWORDS_REGEXP = Regexp.union(INHERITED_KEYWORDS)
+
     # @return [Hash] Possible types for a scheme's 'ExecutionAction' node
     #
     EXECUTION_ACTION_TYPE = {
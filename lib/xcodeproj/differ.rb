@@ -22,6 +22,8 @@ module Xcodeproj
   #
   #
   module Differ
+    autoload :ProjectDiffer, 'xcodeproj/differ/project_differ'
+
     # Computes the recursive difference of two given values.
     #
     # @param  [Object] value_1
@@ -61,14 +63,36 @@ module Xcodeproj
 
     # Optimized for reducing the noise from the tree hash of projects
     #
-    def self.project_diff(project_1, project_2, key_1 = 'project_1', key_2 = 'project_2')
-      project_1 = project_1.to_tree_hash unless project_1.is_a?(Hash)
-      project_2 = project_2.to_tree_hash unless project_2.is_a?(Hash)
+    # @note   If two projects are given their objects are compared directly,
+    #         without building their tree hash (see {ProjectDiffer}).
+    #
+    # @param  [Project, Hash] project_1
+    #         The first project or its tree hash.
+    #
+    # @param  [Project, Hash] project_2
+    #         The second project or its tree hash.
+    #
+    # @param  [Array] ignored_keys
+    #         The keys to remove from the tree hashes before comparing them.
+    #
+    def self.project_diff(project_1, project_2, key_1 = 'project_1', key_2 = 'project_2', ignored_keys = [])
       options = {
         :key_1  => key_1,
         :key_2  => key_2,
         :id_key => 'displayName',
       }
+      if project_1.is_a?(Project) && project_2.is_a?(Project)
+        return Instrumentation.instrument('project.diff', project_1) do
+          ProjectDiffer.new(options.merge(:ignored_keys => ignored_keys)).project_diff(project_1, project_2)
+        end
+      end
+
+      project_1 = project_1.to_tree_hash unless project_1.is_a?(Hash)
+      project_2 = project_2.to_tree_hash unless project_2.is_a?(Hash)
+      ignored_keys.each do |key|
+        project_1 = clean_hash(project_1, key)
+        project_2 = clean_hash(project_2, key)
+      end
       diff(project_1, project_2, options)
     end
 
@@ -121,12 +145,15 @@ module Xcodeproj
       if id_key = options[:id_key]
         matched_value_1 = []
         matched_value_2 = []
+        entries_by_id = nil
         new_objects_value_1.each do |entry_value_1|
           if entry_value_1.is_a?(Hash)
             id_value = entry_value_1[id_key]
-            entry_value_2 = new_objects_value_2.find do |entry|
-              entry[id_key] == id_value
+            entries_by_id ||= new_objects_value_2.each_with_object({}) do |entry, index|
+              entry_id = entry[id_key]
+              index[entry_id] = entry unless index.key?(entry_id)
             end
+            entry_value_2 = entries_by_id[id_value]
             if entry_value_2
               matched_value_1 << entry_value_1
               matched_value_2 << entry_value_2
@@ -246,16 +273,8 @@ module Xcodeproj
     # @return [Array]
     #
     def self.array_non_unique_diff(value_1, value_2)
-      value_2_elements_by_count = value_2.reduce({}) do |hash, element|
-        updated_element_hash = hash.key?(element) ? { element => hash[element] + 1 } : { element => 1 }
-        hash.merge(updated_element_hash)
-      end
-
-      value_1_elements_by_deletions =
-        value_1.to_set.map do |element|
-          times_to_delete_element = value_2_elements_by_count[element] || 0
-          next [element, times_to_delete_element]
-        end.to_h
+      value_1_elements_by_deletions = Hash.new(0)
+      value_2.each { |element| value_1_elements_by_deletions[element] += 1 }
 
       value_1.select do |element|
         if value_1_elements_by_deletions[element] > 0
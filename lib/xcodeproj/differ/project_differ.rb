@@ -0,0 +1,370 @@
+module Xcodeproj
+  module Differ
+    # Computes the diff of two projects working directly on their objects.
+    #
+    # The diff is the same as the one of {Differ.diff} applied to the tree
+    # hashes of the projects (see {Project#to_tree_hash}), but the tree hashes
+    # are never built: the objects are compared through a SHA-256 digest of
+    # their tree hash, which is computed once per object, so the identical
+    # subtrees of the projects are skipped without being traversed, and the
+    # entries of the arrays are matched through hash indexes. The tree hash
+    # of an object is built only when the object is part of the diff.
+    #
+    # @note   Clients are not expected to use this class directly, see
+    #         {Differ.project_diff}.
+    #
+    class ProjectDiffer
+      # @param  [Hash] options
+      #         The options of {Differ.diff} and the `:ignored_keys`, the
+      #         keys which should be removed from the tree hashes before
+      #         comparing them (see {Differ.clean_hash!}).
+      #
+      def initialize(options)
+        @key_1 = options[:key_1]
+        @key_2 = options[:key_2]
+        @id_key = options[:id_key]
+        @ignored_keys = options[:ignored_keys] || []
+        @digests = {}.compare_by_identity
+        @entries = {}.compare_by_identity
+        @cleaned_values = {}.compare_by_identity
+        @custom_tree_hash = {}
+      end
+
+      # @param  [Project] project_1
+      #         The first project to compare.
+      #
+      # @param  [Project] project_2
+      #         The second project to compare.
+      #
+      # @return [Hash] The diff of the projects.
+      # @return [Nil] if the projects are equal.
+      #
+      def project_diff(project_1, project_2)
+        diff(root_hash(project_1), root_hash(project_2))
+      end
+
+      private
+
+      # @!group Diffing
+      #-----------------------------------------------------------------------#
+
+      # @see Differ.diff
+      #
+      def diff(value_1, value_2)
+        if kind(value_1) == kind(value_2)
+          if hash_like?(value_1)
+            hash_diff(value_1, value_2)
+          elsif value_1.is_a?(Array)
+            array_diff(value_1, value_2)
+          else
+            generic_diff(value_1, value_2)
+          end
+        else
+          generic_diff(value_1, value_2)
+        end
+      end
+
+      # @see Differ.hash_diff
+      #
+      def hash_diff(value_1, value_2)
+        return nil if equal?(value_1, value_2)
+
+        entries_1 = entries(value_1)
+        entries_2 = entries(value_2)
+        result = {}
+        (entries_1.keys + entries_2.keys).uniq.each do |key|
+          diff = diff(entries_1[key], entries_2[key])
+          result[key] = diff if diff
+        end
+        result.empty? ? nil : result
+      end
+
+      # @see Differ.array_diff
+      #
+      def array_diff(value_1, value_2)
+        return nil if equal?(value_1, value_2)
+
+        new_objects_value_1 = non_unique_diff(value_1, value_2)
+        new_objects_value_2 = non_unique_diff(value_2, value_1)
+        return nil if value_1.empty? && value_2.empty?
+
+        matched_diff = {}
+        if @id_key
+          matched_value_1 = []
+          matched_value_2 = []
+          entries_by_id = nil
+          new_objects_value_1.each do |entry_value_1|
+            next unless hash_like?(entry_value_1)
+            entries_by_id ||= index_by_id(new_objects_value_2)
+            id_value = id(entry_value_1)
+            next unless entry_value_2 = entries_by_id[id_value]
+            matched_value_1 << entry_value_1
+            matched_value_2 << entry_value_2
+            diff = diff(entry_value_1, entry_value_2)
+            matched_diff[id_value] = diff if diff
+          end
+
+          new_objects_value_1 = subtract(new_objects_value_1, matched_value_1)
+          new_objects_value_2 = subtract(new_objects_value_2, matched_value_2)
+        end
+
+        if new_objects_value_1.empty? && new_objects_value_2.empty?
+          matched_diff.empty? ? nil : matched_diff
+        else
+          result = {}
+          result[@key_1] = new_objects_value_1.map { |value| tree_value(value) } unless new_objects_value_1.empty?
+          result[@key_2] = new_objects_value_2.map { |value| tree_value(value) } unless new_objects_value_2.empty?
+          result[:diff] = matched_diff unless matched_diff.empty?
+          result
+        end
+      end
+
+      # @see Differ.generic_diff
+      #
+      def generic_diff(value_1, value_2)
+        return nil if equal?(value_1, value_2)
+
+        {
+          @key_1 => tree_value(value_1),
+          @key_2 => tree_value(value_2),
+        }
+      end
+
+      # @!group Tree hashes
+      #-----------------------------------------------------------------------#
+
+      # @return [Hash] The tree hash of the given project, whose root object
+      #         is not expanded.
+      #
+      def root_hash(project)
+        clean(
+          'objects' => {},
+          'archiveVersion' => project.archive_version.to_s,
+          'objectVersion' => project.object_version.to_s,
+          'classes' => project.classes,
+          'rootObject' => project.root_object,
+        )
+      end
+
+      # @return [Hash] The entries of the tree hash of the given object or
+      #         the given hash, whose objects are not expanded.
+      #
+      def entries(value)
+        return value unless value.is_a?(Project::Object::AbstractObject)
+        @entries[value] ||= begin
+          hash = if custom_tree_hash?(value)
+                   value.to_tree_hash
+                 else
+                   object_entries(value)
+                 end
+          clean(hash)
+        end
+      end
+
+      # @return [Hash] The entries of the tree hash of an object, as
+      #         {AbstractObject#to_tree_hash} or
+      #         {PBXTargetDependency#to_tree_hash} would build them.
+      #
+      def object_entries(object)
+        hash = {}
+        hash['displayName'] = object.display_name
+        hash['isa'] = object.isa
+
+        if object.is_a?(Project::Object::PBXTargetDependency)
+          hash['targetProxy'] = object.target_proxy if object.target_proxy
+          return hash
+        end
+
+        object.simple_attributes.each do |attrb|
+          value = attrb.get_value(object)
+          hash[attrb.plist_name] = value if value
+        end
+        object.to_one_attributes.each do |attrb|
+          value = attrb.get_value(object)
+          hash[attrb.plist_name] = value if value
+        end
+        object.to_many_attributes.each do |attrb|
+          hash[attrb.plist_name] = attrb.get_value(object).to_a
+        end
+        object.references_by_keys_attributes.each do |attrb|
+          hash[attrb.plist_name] = attrb.get_value(object).map { |dictionary| dictionary_entries(dictionary) }
+        end
+        hash
+      end
+
+      # @return [Hash] The entries of the tree hash of an object dictionary,
+      #         as {ObjectDictionary#to_tree_hash} would build them.
+      #
+      def dictionary_entries(dictionary)
+        hash = {}
+        dictionary.each do |key, object|
+          hash[Project::Object::CaseConverter.convert_to_plist(key, nil)] = object if object
+        end
+        hash
+      end
+
+      # @return [Bool] Whether the class of the given object overrides the
+      #         tree hash of {AbstractObject}.
+      #
+      def custom_tree_hash?(object)
+        @custom_tree_hash.fetch(object.class) do
+          owner = object.method(:to_tree_hash).owner
+          custom = owner != Project::Object::AbstractObject && owner != Project::Object::PBXTargetDependency
+          @custom_tree_hash[object.class] = custom
+        end
+      end
+
+      # @return [Object] The given value with the ignored keys removed from
+      #         its hashes, as {Differ.clean_hash!} would do.
+      #
+      def clean(value)
+        return value if @ignored_keys.empty?
+        case value
+        when Hash
+          @cleaned_values[value] ||= begin
+            hash = value.reject { |key, _| @ignored_keys.include?(key) }
+            hash.each do |key, entry|
+              case entry
+              when Hash then hash[key] = clean(entry)
+              when Array then hash[key] = entry.map { |e| e.is_a?(Hash) ? clean(e) : e }
+              end
+            end
+          end
+        else
+          value
+        end
+      end
+
+      # @return [Object] The given value with its objects expanded to their
+      #         tree hash.
+      #
+      def tree_value(value)
+        case value
+        when Project::Object::AbstractObject
+          Hash[entries(value).map { |key, entry| [key, tree_value(entry)] }]
+        when Array
+          return value unless value.any? { |entry| entry.is_a?(Project::Object::AbstractObject) }
+          value.map { |entry| tree_value(entry) }
+        when Hash
+          return value unless value.each_value.any? { |entry| entry.is_a?(Project::Object::AbstractObject) }
+          Hash[value.map { |key, entry| [key, tree_value(entry)] }]
+        else
+          value
+        end
+      end
+
+      # @!group Comparing
+      #-----------------------------------------------------------------------#
+
+      # @return [Class] The class of the tree representation of the value.
+      #
+      def kind(value)
+        value.is_a?(Project::Object::AbstractObject) ? Hash : value.class
+      end
+
+      # @return [Bool] Whether the tree representation of the value is a hash.
+      #
+      def hash_like?(value)
+        value.is_a?(Hash) || value.is_a?(Project::Object::AbstractObject)
+      end
+
+      # @return [Bool] Whether the tree representations of the given values
+      #         are equal.
+      #
+      def equal?(value_1, value_2)
+        object_1 = value_1.is_a?(Project::Object::AbstractObject)
+        object_2 = value_2.is_a?(Project::Object::AbstractObject)
+        if object_1 && object_2
+          value_1.equal?(value_2) || digest(value_1) == digest(value_2)
+        elsif object_1 || object_2
+          tree_value(value_1) == tree_value(value_2)
+        elsif value_1.is_a?(Array) && value_2.is_a?(Array)
+          value_1.size == value_2.size &&
+            value_1.each_with_index.all? { |entry, index| equal?(entry, value_2[index]) }
+        elsif value_1.is_a?(Hash) && value_2.is_a?(Hash)
+          value_1.size == value_2.size &&
+            value_1.all? { |key, entry| value_2.key?(key) && equal?(entry, value_2[key]) }
+        else
+          value_1 == value_2
+        end
+      end
+
+      # @return [String] The SHA-256 digest of the tree hash of the given
+      #         object, which depends only on the digests of the objects it
+      #         references and not on their identity.
+      #
+      def digest(object)
+        @digests[object] ||= Project::ContentDigest.digest(append_value(Project::ContentDigest.new_buffer, entries(object)))
+      end
+
+      # Appends the given value of a tree hash to the given buffer, replacing
+      # the objects with their digest (see {Project::ContentDigest}).
+      #
+      # @return [String] The buffer.
+      #
+      def append_value(buffer, value)
+        case value
+        when Project::Object::AbstractObject
+          buffer << 'd' << digest(value)
+        when Hash
+          buffer << 'h' << value.size.to_s << ':'
+          value.keys.sort_by(&:to_s).each do |key|
+            Project::ContentDigest.append(buffer, key)
+            append_value(buffer, value[key])
+          end
+          buffer
+        when Array
+          buffer << 'a' << value.size.to_s << ':'
+          value.each { |entry| append_value(buffer, entry) }
+          buffer
+        else
+          Project::ContentDigest.append(buffer, value)
+        end
+      end
+
+      # @return [Object] The key of the given value in the hashes which index
+      #         the entries of an array.
+      #
+      def index_key(value)
+        value.is_a?(Project::Object::AbstractObject) ? [:object, digest(value)] : value
+      end
+
+      # @return [Object] The value of the `id_key` of the given entry.
+      #
+      def id(entry)
+        entries(entry)[@id_key]
+      end
+
+      # @return [Hash] The first entry of the given array for each value of
+      #         the `id_key`.
+      #
+      def index_by_id(array)
+        array.each_with_object({}) do |entry, index|
+          id_value = hash_like?(entry) ? id(entry) : entry[@id_key]
+          index[id_value] = entry unless index.key?(id_value)
+        end
+      end
+
+      # @see Differ.array_non_unique_diff
+      #
+      def non_unique_diff(value_1, value_2)
+        counts = Hash.new(0)
+        value_2.each { |entry| counts[index_key(entry)] += 1 }
+        value_1.reject do |entry|
+          key = index_key(entry)
+          counts[key] -= 1 if counts[key] > 0
+        end
+      end
+
+      # @return [Array] The entries of the given array which are not equal to
+      #         any of the given entries, like `Array#-`.
+      #
+      def subtract(array, entries)
+        return array if entries.empty?
+        keys = {}
+        entries.each { |entry| keys[index_key(entry)] = true }
+        array.reject { |entry| keys.key?(index_key(entry)) }
+      end
+    end
+  end
+end
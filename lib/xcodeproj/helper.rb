@@ -1,3 +1,5 @@
+require 'set'
+
 module Xcodeproj
   module Helper
     class TargetDiff
@@ -18,10 +20,9 @@ module Xcodeproj
       #         list is sorted by file path.
       #
       def new_source_build_files
+        target1_paths = Set.new(@target1.source_build_phase.files.map { |build_file| build_file.file_ref.path })
         new = @target2.source_build_phase.files.reject do |target2_build_file|
-          @target1.source_build_phase.files.any? do |target1_build_file|
-            target1_build_file.file_ref.path == target2_build_file.file_ref.path
-          end
+          target1_paths.include?(target2_build_file.file_ref.path)
         end
         new.sort_by { |build_file| build_file.file_ref.path }
       end
@@ -0,0 +1,172 @@
+module Xcodeproj
+  # Publishes events for the phases of the main operations of Xcodeproj, like
+  # opening, saving or sorting a project, to the subscribers.
+  #
+  # Each event has the duration of the phase and the number of objects
+  # allocated during it and, if a subscriber asks for them, the number of
+  # objects of the project at the end of the phase. The names of the events
+  # are hierarchical: the phases of an operation are named after it, e.g.
+  # `project.open.parse` is a phase of `project.open`.
+  #
+  # Nothing is measured when there is no subscriber, so the phases only cost
+  # a check of the list of the subscribers.
+  #
+  # @example Printing the duration of the phases of opening a project
+  #
+  #   subscriber = Xcodeproj::Instrumentation.subscribe(/^project\.open/) do |event|
+  #     puts "#{event.name}: #{event.duration}"
+  #   end
+  #   Xcodeproj::Project.open('App.xcodeproj')
+  #   Xcodeproj::Instrumentation.unsubscribe(subscriber)
+  #
+  module Instrumentation
+    require 'xcodeproj/instrumentation/profiler'
+
+    # An event published at the end of a phase.
+    #
+    class Event
+      # @return [String] the name of the phase.
+      #
+      attr_reader :name
+
+      # @return [Float] the duration of the phase in seconds.
+      #
+      attr_reader :duration
+
+      # @return [Integer] the number of objects allocated during the phase.
+      #
+      attr_reader :allocations
+
+      # @return [Object] the object the phase applied to, e.g. a project or a
+      #         target.
+      #
+      attr_reader :subject
+
+      # @return [Hash{String => Integer}] the number of objects of the project
+      #         of the subject by ISA, counted when the phase ended. The
+      #         objects of a lazily opened project which have not been
+      #         initialized yet are not counted.
+      # @return [Nil] if no subscriber of the event asked for them, see
+      #         {Instrumentation.subscribe}.
+      #
+      attr_reader :object_counts
+
+      # @param  [String] name
+      # @param  [Float] duration
+      # @param  [Integer] allocations
+      # @param  [Object] subject
+      # @param  [Hash{String => Integer}] object_counts
+      #
+      def initialize(name, duration, allocations, subject, object_counts = nil)
+        @name = name
+        @duration = duration
+        @allocations = allocations
+        @subject = subject
+        @object_counts = object_counts
+      end
+
+      # @param  [Object] subject
+      #         the object a phase applied to.
+      #
+      # @return [Hash{String => Integer}] the number of objects by ISA of the
+      #         project of the given subject, empty if it has no project.
+      #
+      def self.count_objects(subject)
+        project = subject.is_a?(Project) ? subject : (subject.project if subject.respond_to?(:project))
+        counts = Hash.new(0)
+        project.loaded_objects_by_uuid.each_value { |object| counts[object.isa] += 1 } if project
+        counts
+      end
+    end
+
+    @subscribers = [].freeze
+
+    class << self
+      # Subscribes to the events whose name matches the given pattern.
+      #
+      # @param  [String, Regexp, Nil] pattern
+      #         the name of the events, a pattern matching it or nil for all
+      #         the events.
+      #
+      # @param  [Hash] options
+      #         the options of the subscription.
+      #
+      # @option options [Bool] :object_counts
+      #         whether the objects of the project of the subject are counted
+      #         at the end of each phase, see {Event#object_counts}. Counting
+      #         the objects is proportional to the size of the project, so
+      #         it is not included in the duration of the phase, but it is in
+      #         the one of the operation which contains it.
+      #
+      # @yieldparam [Event] event
+      #         an event published at the end of a phase.
+      #
+      # @return [Object] the subscriber, to unsubscribe.
+      #
+      def subscribe(pattern = nil, options = {}, &block)
+        raise ArgumentError, '[Xcodeproj] A block is required to subscribe to the events.' unless block
+        subscriber = [pattern, block, options[:object_counts]]
+        @subscribers = (@subscribers + [subscriber]).freeze
+        subscriber
+      end
+
+      # Removes a subscriber.
+      #
+      # @param  [Object] subscriber
+      #         the value returned by {subscribe}.
+      #
+      # @return [void]
+      #
+      def unsubscribe(subscriber)
+        @subscribers = @subscribers.reject { |s| s.equal?(subscriber) }.freeze
+      end
+
+      # @return [Bool] whether there is any subscriber.
+      #
+      def subscribed?
+        !@subscribers.empty?
+      end
+
+      # Runs a phase and publishes its event if there is any subscriber.
+      #
+      # @param  [String] name
+      #         the name of the phase.
+      #
+      # @param  [Object] subject
+      #         the object the phase applies to.
+      #
+      # @return [Object] the value of the block.
+      #
+      def instrument(name, subject = nil)
+        return yield if @subscribers.empty?
+
+        allocations = GC.stat(:total_allocated_objects)
+        start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        begin
+          yield
+        ensure
+          duration = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+          publish(name, duration, GC.stat(:total_allocated_objects) - allocations, subject)
+        end
+      end
+
+      # Publishes the event of a phase measured by the caller, for the
+      # phases which are not contiguous.
+      #
+      # @param  [String] name
+      # @param  [Float] duration
+      # @param  [Integer] allocations
+      # @param  [Object] subject
+      #
+      # @return [void]
+      #
+      def publish(name, duration, allocations, subject = nil)
+        subscribers = @subscribers.select { |pattern, _| pattern.nil? || pattern === name }
+        return if subscribers.empty?
+        object_counts = Event.count_objects(subject) if subscribers.any? { |_, _, counts| counts }
+        event = Event.new(name, duration, allocations, subject, object_counts)
+        subscribers.each { |_, block| block.call(event) }
+      end
+    end
+  end
+end
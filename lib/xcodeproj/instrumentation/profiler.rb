@@ -0,0 +1,104 @@
+module Xcodeproj
+  module Instrumentation
+    # Collects the events of the phases and summarizes them, for the
+    # `--profile` option of the commands.
+    #
+    class Profiler
+      # @return [Hash{String => Hash}] the number of events, the total
+      #         duration and the total allocations of each phase, in the
+      #         order in which the phases ended first.
+      #
+      attr_reader :phases
+
+      def initialize
+        @phases = {}
+      end
+
+      # @return [Hash{String => Integer}] the number of objects by ISA of the
+      #         project at the end of the last phase which applied to a
+      #         project or to one of its objects.
+      #
+      def object_counts
+        @last_project_event ? @last_project_event.object_counts : {}
+      end
+
+      # Starts collecting the events.
+      #
+      # @return [void]
+      #
+      def start
+        @subscriber ||= Instrumentation.subscribe(nil, :object_counts => true) { |event| record(event) }
+      end
+
+      # Stops collecting the events.
+      #
+      # @return [void]
+      #
+      def stop
+        Instrumentation.unsubscribe(@subscriber) if @subscriber
+        @subscriber = nil
+      end
+
+      # Adds an event to the summary.
+      #
+      # @param  [Event] event
+      #
+      # @return [void]
+      #
+      def record(event)
+        phase = @phases[event.name] ||= { :count => 0, :duration => 0.0, :allocations => 0 }
+        phase[:count] += 1
+        phase[:duration] += event.duration
+        phase[:allocations] += event.allocations
+        @last_project_event = event if event.object_counts && !event.object_counts.empty?
+      end
+
+      # @return [String] the summary of the phases, each one indented under
+      #         the operation it belongs to, followed by the number of objects
+      #         by ISA at the end of the last phase which applied to a
+      #         project.
+      #
+      def report
+        lines = ['Phase'.ljust(48) + 'Calls'.rjust(8) + 'Time (ms)'.rjust(12) + 'Allocations'.rjust(14)]
+        sorted_phases.each do |name, phase|
+          ancestors = ancestors(name)
+          label = '  ' * ancestors.count + (ancestors.empty? ? name : name[ancestors.last.length + 1..-1])
+          lines << label.ljust(48) +
+            phase[:count].to_s.rjust(8) +
+            format('%.1f', phase[:duration] * 1000).rjust(12) +
+            phase[:allocations].to_s.rjust(14)
+        end
+        unless object_counts.empty?
+          lines << ''
+          lines << "Objects at the end of #{@last_project_event.name}"
+          lines << 'ISA'.ljust(48) + 'Objects'.rjust(8)
+          object_counts.sort_by { |isa, count| [-count, isa] }.each do |isa, count|
+            lines << isa.ljust(48) + count.to_s.rjust(8)
+          end
+        end
+        lines.join("\n")
+      end
+
+      private
+
+      # @return [Array<Array(String, Hash)>] the phases with each one after
+      #         the operation which contains it, in the order in which the
+      #         operations ended.
+      #
+      def sorted_phases
+        order = Hash[@phases.keys.each_with_index.to_a]
+        @phases.sort_by do |name, _|
+          (ancestors(name) + [name]).map { |phase| order[phase] }
+        end
+      end
+
+      # @return [Array<String>] the recorded phases which contain the given
+      #         phase, from the outermost one.
+      #
+      def ancestors(name)
+        parts = name.split('.')
+        (1...parts.count).map { |length| parts.first(length).join('.') }.select { |prefix| @phases.key?(prefix) }
+      end
+    end
+  end
+end
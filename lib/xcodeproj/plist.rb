@@ -13,10 +13,20 @@ module Xcodeproj
     #
     def self.read_from_path(path)
       path = path.to_s
-      unless File.exist?(path)
-        raise Informative, "The plist file at path `#{path}` doesn't exist."
-      end
-      contents = File.read(path)
+      read_from_contents(read_contents(path), path)
+    end
+
+    # @return [Hash] Returns the native objects loaded from the contents of a
+    #         property list file.
+    #
+    # @param  [String] contents
+    #         The contents of the file, as returned by {read_contents}. The
+    #         string is handed to the parsers as is, without being copied.
+    #
+    # @param  [#to_s] path
+    #         The path of the file, used in the error messages.
+    #
+    def self.read_from_contents(contents, path)
       if file_in_conflict?(contents)
         raise Informative, "The file `#{path}` is in a merge conflict."
       end
@@ -28,6 +38,21 @@ module Xcodeproj
       end
     end
 
+    # @return [String] Returns the contents of a property list file, read
+    #         with a single read into a frozen buffer which can be shared by
+    #         the parsers and the callers.
+    #
+    # @param  [#to_s] path
+    #         The path of the file.
+    #
+    def self.read_contents(path)
+      path = path.to_s
+      unless File.exist?(path)
+        raise Informative, "The plist file at path `#{path}` doesn't exist."
+      end
+      File.read(path).freeze
+    end
+
     # Serializes a hash as an XML property list file.
     #
     # @param  [#to_hash] hash
@@ -80,15 +105,32 @@ module Xcodeproj
     # @param  [#to_s] contents
     #         The contents of the file.
     #
+    # @note   The markers of a conflict are lines starting with exactly 7
+    #         left arrows, 7 equality symbols and 7 right arrows, in this
+    #         order. They are looked up one after the other in a single pass
+    #         over the contents, which stops as soon as the last one is found
+    #         or as soon as one of them is missing.
+    #
     def self.file_in_conflict?(contents)
-      conflict_regex = /
-        ^<{7}(?!<) # Exactly 7 left arrows at the beginning of the line
-        [\w\W]* # Anything
-        ^={7}(?!=) # Exactly 7 equality symbols at the beginning of the line
-        [\w\W]* # Anything
-        ^>{7}(?!>) # Exactly 7 right arrows at the beginning of the line
-      /xm
-      contents.match(conflict_regex)
+      contents = contents.to_s
+      position = 0
+      CONFLICT_MARKERS.each do |marker, pattern|
+        return false unless contents.include?(marker)
+        position = contents.index(pattern, position)
+        return false unless position
+        position += marker.length
+      end
+      true
     end
+
+    # @return [Array<Array(String, Regexp)>] The markers of a merge conflict,
+    #         in order, with the patterns which match them at the beginning of
+    #         a line.
+    #
+    CONFLICT_MARKERS = [
+      ['<' * 7, /^<{7}(?!<)/],
+      ['=' * 7, /^={7}(?!=)/],
+      ['>' * 7, /^>{7}(?!>)/],
+    ].freeze
   end
 end
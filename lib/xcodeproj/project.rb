@@ -1,12 +1,20 @@
 # frozen_string_literal: true
-require 'atomos'
+require 'digest'
+require 'etc'
 require 'fileutils'
 require 'securerandom'
+require 'set'
 
+require 'xcodeproj/project/object_index'
 require 'xcodeproj/project/object'
 require 'xcodeproj/project/project_helper'
 require 'xcodeproj/project/uuid_generator'
 require 'xcodeproj/plist'
+require 'xcodeproj/project/streaming_writer'
+require 'xcodeproj/project/snapshot_cache'
+require 'xcodeproj/project/transaction'
+require 'xcodeproj/project/fork_source'
+require 'xcodeproj/project/content_digest'
 
 module Xcodeproj
   # This class represents a Xcode project document.
@@ -57,23 +65,39 @@ module Xcodeproj
     #         Wether the project should be initialized from scratch.
     # @param  [Int] object_version
     #         Object version to use for serialization, defaults to Xcode 3.2 compatible.
+    # @param  [String] uuid_seed
+    #         The seed of the UUIDs of the new objects, see {#uuid_seed}.
     #
     # @example Creating a project
     #         Project.new("path/to/Project.xcodeproj")
     #
+    # @example Creating a project with reproducible UUIDs
+    #         Project.new("path/to/Project.xcodeproj", :uuid_seed => 'MyApp')
+    #
     # @note When initializing the project, Xcodeproj mimics the Xcode behaviour
     #       including the setup of a debug and release configuration. If you want a
     #       clean project without any configurations, you should override the
     #       `initialize_from_scratch` method to not add these configurations and
     #       manually set the object version.
     #
-    def initialize(path, skip_initialization = false, object_version = Constants::DEFAULT_OBJECT_VERSION)
+    def initialize(path, skip_initialization = false, object_version = Constants::DEFAULT_OBJECT_VERSION, uuid_seed: nil)
       @path = Pathname.new(path).expand_path
       @project_dir = @path.dirname
       @objects_by_uuid = {}
-      @generated_uuids = []
+      @object_index    = ObjectIndex.new
+      @generated_uuids = Set.new
       @available_uuids = []
+      @uuid_seed       = uuid_seed
+      @uuid_counter    = 0
       @dirty           = true
+      @objects_changed_since_sort = nil
+      @objects_to_sort = nil
+      @sort_build_phases = false
+      @sort_options = nil
+      @current_transaction = nil
+      @fork_store = nil
+      @preserving_for_forks = false
+      @objects_with_read_values = nil
       unless skip_initialization.is_a?(TrueClass) || skip_initialization.is_a?(FalseClass)
         raise ArgumentError, '[Xcodeproj] Initialization parameter expected to ' \
           "be a boolean #{skip_initialization}"
@@ -101,16 +125,42 @@ module Xcodeproj
     # @raise  If it can't find the root object. This means that the project is
     #         malformed.
     #
+    # @param  [Boolean] lazy
+    #         Whether the relationships of the objects should be initialized
+    #         only when they are first accessed. This reduces the cost of
+    #         opening large projects when only a small part of the object
+    #         graph is inspected. Any operation which needs the whole graph
+    #         (e.g. {#objects_by_uuid}, {#save} or the referrers of an object)
+    #         initializes the remaining objects transparently.
+    #
     # @example Opening a project
     #         Project.open("path/to/Project.xcodeproj")
     #
-    def self.open(path)
+    # @example Opening a project lazily
+    #         Project.open("path/to/Project.xcodeproj", lazy: true)
+    #
+    # @param  [String] uuid_seed
+    #         The seed of the UUIDs of the new objects, see {#uuid_seed}.
+    #
+    # @param  [#to_s] snapshot_cache
+    #         The directory of the snapshots of the parsed `project.pbxproj`
+    #         files, see {SnapshotCache}. When the contents of the file match
+    #         a snapshot they are loaded from it instead of being parsed.
+    #         Defaults to the `XCODEPROJ_SNAPSHOT_CACHE` environment variable,
+    #         the snapshots are not used if it is not set.
+    #
+    # @example Opening a project with a snapshot cache
+    #         Project.open("path/to/Project.xcodeproj", snapshot_cache: "tmp/xcodeproj")
+    #
+    def self.open(path, lazy: false, uuid_seed: nil, snapshot_cache: ENV['XCODEPROJ_SNAPSHOT_CACHE'])
       path = Pathname.pwd + path
       unless Pathname.new(path).exist?
         raise "[Xcodeproj] Unable to open `#{path}` because it doesn't exist."
       end
-      project = new(path, true)
-      project.send(:initialize_from_file)
+      project = new(path, true, :uuid_seed => uuid_seed)
+      Instrumentation.instrument('project.open', project) do
+        project.send(:initialize_from_file, :lazy => lazy, :snapshot_cache => snapshot_cache)
+      end
       project
     end
 
@@ -129,7 +179,61 @@ module Xcodeproj
     # @return [Hash{String => AbstractObject}] A hash containing all the
     #         objects of the project by UUID.
     #
-    attr_reader :objects_by_uuid
+    # @note   If the project has been opened lazily, any object which has not
+    #         been initialized yet is initialized before returning.
+    #
+    def objects_by_uuid
+      materialize_pending_objects if @pending_objects_plist
+      @objects_by_uuid
+    end
+
+    # @return [Hash{String => AbstractObject}] The objects of the project by
+    #         UUID which have been initialized so far. Unlike
+    #         {#objects_by_uuid} this never initializes the pending objects
+    #         of a lazily opened project.
+    #
+    # @visibility private
+    #
+    def loaded_objects_by_uuid
+      @objects_by_uuid
+    end
+
+    # @return [Hash, ForkSource] The plists of the objects of a lazily
+    #         opened project, from which the objects which have not been
+    #         initialized yet are initialized.
+    # @return [Nil] If all the objects have been initialized.
+    #
+    # @visibility private
+    #
+    def pending_objects_plist
+      @pending_objects_plist
+    end
+
+    # @return [ObjectIndex] The secondary indexes of the objects of the
+    #         project.
+    #
+    # @visibility private
+    #
+    attr_reader :object_index
+
+    # @return [Transaction] The transaction in progress, see {#transaction}.
+    # @return [Nil] If there is no transaction in progress.
+    #
+    # @visibility private
+    #
+    attr_reader :current_transaction
+
+    # Checks that the secondary indexes of the project, which are updated
+    # incrementally, are consistent with its objects. Intended to be used
+    # while debugging.
+    #
+    # @raise  If any of the indexes is not consistent.
+    #
+    # @return [void]
+    #
+    def verify_object_index!
+      object_index.verify!(objects)
+    end
 
     # @return [PBXProject] the root object of the project.
     #
@@ -154,10 +258,10 @@ module Xcodeproj
 
     # Compares the project to another one, or to a plist representation.
     #
-    # @note This operation can be extremely expensive, because it converts a
-    #       `Project` instance to a hash, and should _only_ ever be used to
-    #       determine wether or not the data contents of two `Project` instances
-    #       are completely equal.
+    # @note Two projects are compared through their {#digest}, which is
+    #       computed once and then updated incrementally as the projects are
+    #       modified. Comparing the project to a plist representation instead
+    #       converts the project to a hash and can be extremely expensive.
     #
     #       To simply determine wether or not two {Project} instances refer to
     #       the same projects on disk, use the {#==} method instead.
@@ -167,6 +271,7 @@ module Xcodeproj
     # @return [Boolean] whether the project is equivalent to the given object.
     #
     def eql?(other)
+      return digest == other.digest if other.is_a?(Project)
       other.respond_to?(:to_hash) && to_hash == other.to_hash
     end
 
@@ -206,11 +311,44 @@ module Xcodeproj
 
     # Initializes the instance with the project stored in the `path` attribute.
     #
-    def initialize_from_file
+    # @param  [Boolean] lazy
+    #         Whether the relationships of the objects should be initialized
+    #         on demand. See {Project.open}.
+    #
+    # @param  [#to_s] snapshot_cache
+    #         The directory of the snapshots of the parsed files, if any. See
+    #         {Project.open}.
+    #
+    def initialize_from_file(lazy: false, snapshot_cache: nil)
       pbxproj_path = path + 'project.pbxproj'
-      plist = Plist.read_from_path(pbxproj_path.to_s)
+      plist = if snapshot_cache && !snapshot_cache.to_s.empty?
+                SnapshotCache.new(snapshot_cache).fetch(pbxproj_path, self)
+              else
+                Instrumentation.instrument('project.open.parse', self) do
+                  Plist.read_from_path(pbxproj_path.to_s)
+                end
+              end
       root_object.remove_referrer(self) if root_object
-      @root_object     = new_from_plist(plist['rootObject'], plist['objects'], self)
+      if lazy
+        @pending_objects_plist = plist['objects']
+        @pending_objects = {}.compare_by_identity
+      end
+      @root_object = Instrumentation.instrument('project.open.objects', self) do
+        new_from_plist(plist['rootObject'], plist['objects'], self)
+      end
+      Instrumentation.instrument('project.open.fixups', self) do
+        initialize_fixups(pbxproj_path, plist)
+      end
+    end
+
+    private
+
+    # Validates the versions of the project read from the given plist and
+    # fixes up its objects.
+    #
+    # @return [void]
+    #
+    def initialize_fixups(pbxproj_path, plist)
       @archive_version = plist['archiveVersion']
       @object_version  = plist['objectVersion']
       @classes         = plist['classes'] || {}
@@ -234,6 +372,82 @@ module Xcodeproj
 
     public
 
+    # @!group Lazy initialization
+    #-------------------------------------------------------------------------#
+
+    # @return [Boolean] Whether the project has been opened lazily and some of
+    #         its objects still need to initialize their relationships.
+    #
+    def lazily_loaded?
+      !@pending_objects_plist.nil?
+    end
+
+    # Registers an object whose relationships should be initialized on
+    # demand.
+    #
+    # @param  [AbstractObject] object
+    #         The object initialized only with its simple attributes.
+    #
+    # @return [Boolean] Whether the relationships of the object have been
+    #         deferred.
+    #
+    # @visibility private
+    #
+    def defer_object_relationships(object)
+      return false unless @pending_objects_plist
+      @pending_objects[object] = true
+      true
+    end
+
+    # Initializes the relationships of an object which has been deferred by
+    # {#defer_object_relationships}.
+    #
+    # @note   Initializing the relationships doesn't change the dirty state
+    #         of the project, as the object graph is the one read from disk,
+    #         nor records the object for the forks of the project.
+    #
+    # @param  [AbstractObject] object
+    #         The object to initialize.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def materialize_object(object)
+      objects_plist = @pending_objects_plist
+      return unless objects_plist && @pending_objects.delete(object)
+      dirty = @dirty
+      preserving_for_forks { object.configure_relationships_with_plist(objects_plist) }
+      @dirty = dirty
+      finish_lazy_loading if @pending_objects.empty?
+    end
+
+    # Initializes the relationships of all the objects of a lazily opened
+    # project, so that the object graph is the same as the one of a project
+    # opened eagerly.
+    #
+    # @return [void]
+    #
+    def materialize_pending_objects
+      until @pending_objects.nil? || @pending_objects.empty?
+        materialize_object(@pending_objects.first.first)
+      end
+    end
+
+    private
+
+    # Drops the plist retained to initialize the objects on demand once every
+    # object has been initialized.
+    #
+    # @return [void]
+    #
+    def finish_lazy_loading
+      @pending_objects_plist = nil
+      @pending_objects = nil
+    end
+
+    public
+
     # @!group Plist serialization
     #-------------------------------------------------------------------------#
 
@@ -267,8 +481,10 @@ module Xcodeproj
       if attributes
         klass = Object.const_get(attributes['isa'])
         object = klass.new(self, uuid)
-        objects_by_uuid[uuid] = object
+        @objects_by_uuid[uuid] = object
+        @object_index.object_added(object)
         object.add_referrer(self) if root_object
+        @fork_store.preserve_pending(uuid, attributes) if @fork_store && @pending_objects_plist
         object.configure_with_plist(objects_by_uuid_plist)
         object
       end
@@ -288,16 +504,30 @@ module Xcodeproj
       plist
     end
 
+    # @return [Nanaimo::Plist] The ASCII plist representation of the project.
+    #
+    # @note   The representation of each object is cached until the object,
+    #         or any object it references, is modified, so serializing the
+    #         project again costs proportionally to the number of modified
+    #         objects.
+    #
     def to_ascii_plist
+      @current_transaction.apply_changes if @current_transaction
+      refresh_ascii_plist_caches
       plist = {}
       objects_dictionary = {}
+      uncached = []
       objects
         .sort_by { |o| [o.isa, o.uuid] }
         .each do |obj|
           key = Nanaimo::String.new(obj.uuid, obj.ascii_plist_annotation)
-          value = obj.to_ascii_plist.tap { |a| a.annotation = nil }
+          unless value = obj.cached_ascii_plist
+            value = obj.to_ascii_plist.tap { |a| a.annotation = nil }
+            uncached << [obj, value]
+          end
           objects_dictionary[key] = value
         end
+      uncached.each { |obj, value| obj.cache_ascii_plist(value) }
       plist['archiveVersion'] =  archive_version.to_s
       plist['classes']        =  classes
       plist['objectVersion']  =  object_version.to_s
@@ -354,15 +584,25 @@ module Xcodeproj
     #   project.save
     #   project.save
     #
+    # @note   The project is serialized once, to a temporary file next to the
+    #         file while digesting the contents, and the file is replaced
+    #         only if its digest differs, so saving an unchanged project
+    #         doesn't touch the file.
+    #
+    # @note   The project cannot be saved during a transaction, see
+    #         {#transaction}, as the file would keep the changes of a
+    #         transaction which is rolled back.
+    #
     # @return [void]
     #
     def save(save_path = nil)
+      raise '[Xcodeproj] The project cannot be saved during a transaction.' if @current_transaction
       save_path ||= path
       @dirty = false if save_path == path
       FileUtils.mkdir_p(save_path)
       file = File.join(save_path, 'project.pbxproj')
-      Atomos.atomic_write(file) do |f|
-        Nanaimo::Writer::PBXProjWriter.new(to_ascii_plist, :pretty => true, :output => f, :strict => false).write
+      Instrumentation.instrument('project.save', self) do
+        write_if_changed(file) { |output| StreamingWriter.new(self, output).write }
       end
     end
 
@@ -378,6 +618,7 @@ module Xcodeproj
     #         disk or saved.
     #
     def dirty?
+      @current_transaction.apply_changes if @current_transaction
       @dirty == true
     end
 
@@ -393,6 +634,7 @@ module Xcodeproj
     # @return [void]
     #
     def predictabilize_uuids
+      raise '[Xcodeproj] The UUIDs cannot be predictabilized during a transaction.' if @current_transaction
       UUIDGenerator.new([self]).generate!
     end
 
@@ -435,6 +677,7 @@ module Xcodeproj
         klass = Object.const_get(klass)
       end
       object = klass.new(self, generate_uuid)
+      @current_transaction.object_created(object) if @current_transaction
       object.initialize_defaults
       object
     end
@@ -462,7 +705,20 @@ module Xcodeproj
     #         generated but used for objects which are not yet part of the
     #         `objects` hash but which might be added at a later time.
     #
-    attr_reader :generated_uuids
+    # @note   The UUIDs are stored in a set, see {#uuid_known?}.
+    #
+    def generated_uuids
+      @generated_uuids.to_a
+    end
+
+    # @return [String] the seed of the UUIDs of the new objects. When set,
+    #         the UUIDs are derived from the seed and from a counter instead
+    #         of being random, so the same sequence of operations produces
+    #         the same project, without the need to call
+    #         {#predictabilize_uuids}.
+    # @return [Nil] if the UUIDs are random.
+    #
+    attr_reader :uuid_seed
 
     # Pre-generates the given number of UUIDs. Useful for optimizing
     # performance when the rough number of objects that will be created is
@@ -478,10 +734,360 @@ module Xcodeproj
     # @return [void]
     #
     def generate_available_uuid_list(count = 100)
-      new_uuids = (0..count).map { SecureRandom.hex(12).upcase }
-      uniques = (new_uuids - (@generated_uuids + uuids))
-      @generated_uuids += uniques
-      @available_uuids += uniques
+      (0..count).each do
+        uuid = uuid_seed ? seeded_uuid : SecureRandom.hex(12).upcase
+        next if uuid_known?(uuid)
+        @generated_uuids << uuid
+        @available_uuids << uuid
+      end
+    end
+
+    private
+
+    # @return [String] the UUID which follows the last one derived from
+    #         {#uuid_seed}.
+    #
+    def seeded_uuid
+      @uuid_counter += 1
+      Digest::MD5.hexdigest("#{uuid_seed}-#{@uuid_counter}")[0, 24].upcase
+    end
+
+    # @return [Boolean] whether the given UUID has already been generated or
+    #         belongs to an object of the project.
+    #
+    def uuid_known?(uuid)
+      @generated_uuids.include?(uuid) ||
+        @objects_by_uuid.key?(uuid) ||
+        (@pending_objects_plist && @pending_objects_plist.key?(uuid))
+    end
+
+    public
+
+    # @!group Removing objects
+    #-------------------------------------------------------------------------#
+
+    # Removes the given objects from the project, as {AbstractObject#remove_from_project}
+    # would do for each of them, including the build files which reference
+    # them.
+    #
+    # Unlike removing the objects one by one, the relationships of each
+    # referrer are visited only once, which makes the removal of many objects
+    # from the same group or build phase linear in the size of the lists.
+    #
+    # @param  [Array<AbstractObject>] objects
+    #         The objects to remove.
+    #
+    # @return [void]
+    #
+    def remove_objects(objects)
+      materialize_pending_objects if lazily_loaded?
+      removed = {}.compare_by_identity
+      objects.each do |object|
+        removed[object] = true
+        object.build_files.each { |build_file| removed[build_file] = true } if object.respond_to?(:build_files)
+      end
+      return if removed.empty?
+
+      referrers = {}.compare_by_identity
+      removed.each_key do |object|
+        object.referrers.each { |referrer| referrers[referrer] = true if referrer.is_a?(AbstractObject) }
+      end
+      referrers.each_key { |referrer| referrer.remove_references(removed) }
+      removed.each_key(&:remove_from_project)
+    end
+
+    public
+
+    # @!group Transactions
+    #-------------------------------------------------------------------------#
+
+    # Performs the modifications of the given block as a single transaction.
+    #
+    # The bookkeeping which normally follows each modification of an object
+    # is deferred and performed in a batch: the type checking of the new
+    # values and the marking of the project as dirty when the block returns,
+    # the updates of the secondary indexes when they are queried. This makes
+    # generating many objects cheaper.
+    #
+    # If an exception is raised by the block, or by the type checking of the
+    # new values, the objects are restored to their state before the
+    # transaction, the objects created by it are removed from the project
+    # and the exception is raised again.
+    #
+    # @note   A transaction started during another one is part of the outer
+    #         one.
+    #
+    # @note   The values of the simple attributes modified in place are
+    #         restored only if they are hashes or arrays, e.g. the build
+    #         settings.
+    #
+    # @note   The UUIDs generated during a rolled back transaction are not
+    #         reused.
+    #
+    # @example Adding many files
+    #   project.transaction do
+    #     paths.each { |path| target.add_file_references([group.new_file(path)]) }
+    #   end
+    #
+    # @yieldparam [Project] project
+    #         The project.
+    #
+    # @return [Object] The value returned by the block.
+    #
+    def transaction
+      return yield(self) if @current_transaction
+      materialize_pending_objects if lazily_loaded?
+      transaction = Transaction.new(self)
+      state = [@dirty, @objects_changed_since_sort && @objects_changed_since_sort.dup, @sort_options]
+      @current_transaction = transaction
+      @object_index.defer_updates
+      begin
+        result = yield(self)
+        transaction.validate!
+      rescue Exception # rubocop:disable Lint/RescueException
+        @current_transaction = nil
+        transaction.rollback
+        @dirty, @objects_changed_since_sort, @sort_options = state
+        @object_index = ObjectIndex.new
+        @objects_by_uuid.each_value { |object| @object_index.object_added(object) }
+        raise
+      end
+      @current_transaction = nil
+      @object_index.resume_updates
+      transaction.apply_changes
+      result
+    end
+
+    # @!group Forks
+    #-------------------------------------------------------------------------#
+
+    # Returns an independent copy of the project, which can be modified and
+    # saved without affecting the project, and vice versa.
+    #
+    # The fork doesn't copy the objects of the project upfront: as with a
+    # project opened lazily (see {Project.open}), each object is initialized
+    # the first time it is reached, from the plist of the object of the
+    # project. Before the project modifies one of its objects for the first
+    # time, its plist is recorded once for all the forks which might still
+    # need it. So the cost of a fork is proportional to the objects it
+    # accesses and to the objects the project modifies, rather than to the
+    # size of the project.
+    #
+    # @note   The objects of the fork are distinct from the ones of the
+    #         project, as an object belongs to a single project.
+    #
+    # @note   The strings of the attributes of the objects of the fork are
+    #         frozen, as they are shared with the plists recorded for the
+    #         forks.
+    #
+    # @note   If the project has been opened lazily, or is itself a fork,
+    #         the objects it has not initialized yet are read by the fork
+    #         from the plist of the project, which is preserved for the forks
+    #         as they are initialized.
+    #
+    # @note   The fork doesn't share the objects of the project, so the forks
+    #         which access all their objects, for example to be saved, cost
+    #         as much memory as the project itself, apart from the frozen
+    #         strings they share.
+    #
+    # @param  [Pathname, String] path
+    #         The path of the fork, the path of the project by default.
+    #
+    # @return [Project] The fork.
+    #
+    def fork(path = nil)
+      raise '[Xcodeproj] The project cannot be forked during a transaction.' if @current_transaction
+      source = (@fork_store ||= ForkSource::Store.new(self)).new_source
+      fork = self.class.new(path || self.path, true, :uuid_seed => uuid_seed)
+      fork.send(:initialize_from_fork, self, source)
+      fork
+    end
+
+    # Records the plist of the given object for the forks of the project,
+    # before it is modified for the first time since they have been created.
+    #
+    # @param  [AbstractObject] object
+    #         The object about to be modified.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def preserve_for_forks(object)
+      return if @fork_store.nil? || @preserving_for_forks
+      @fork_store.preserve(object)
+    end
+
+    # Records the plists of all the objects for the forks of the project,
+    # before their UUIDs are changed.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def preserve_all_for_forks
+      return if @fork_store.nil?
+      @fork_store.preserve_all
+    end
+
+    # Runs the given block, during which reading the attributes of the
+    # objects doesn't record them for the forks, as the plists of the objects
+    # are computed from their attributes.
+    #
+    # @return [Object] The value returned by the block.
+    #
+    # @visibility private
+    #
+    def preserving_for_forks
+      preserving = @preserving_for_forks
+      @preserving_for_forks = true
+      yield
+    ensure
+      @preserving_for_forks = preserving
+    end
+
+    private
+
+    # Initializes the instance as a fork of the given project.
+    #
+    # @param  [Project] project
+    #         The forked project.
+    #
+    # @param  [ForkSource] source
+    #         The objects of the project.
+    #
+    # @return [void]
+    #
+    def initialize_from_fork(project, source)
+      @archive_version = project.archive_version
+      @object_version = project.object_version
+      @classes = Marshal.load(Marshal.dump(project.classes))
+      @pending_objects_plist = source
+      @pending_objects = {}.compare_by_identity
+      @root_object = new_from_plist(project.root_object.uuid, source, self)
+      @dirty = project.dirty?
+    end
+
+    public
+
+    # @!group Content digests
+    #-------------------------------------------------------------------------#
+
+    # Returns the digest of the contents of the project, which changes
+    # whenever the project is modified and can be used as a change-detection
+    # key. Two projects have the same digest if their plists are equal.
+    #
+    # The digest of the project is derived from the digest of its root
+    # object (see {Object::AbstractObject#digest}), which includes the
+    # digests of all the objects reachable from it. The digests are cached
+    # until the objects are modified, and as the modification of an object
+    # discards the digests of the objects which include it, after a change
+    # only the modified objects and their ancestors are digested again.
+    #
+    # @note   If the project has been opened lazily, the objects are
+    #         initialized as they are digested.
+    #
+    # @return [String] The digest of the contents of the project.
+    #
+    def digest
+      contents = [archive_version.to_s, object_version.to_s, classes, root_object.digest]
+      ContentDigest.hexdigest(ContentDigest.append(ContentDigest.new_buffer, contents))
+    end
+
+    # Records that a value of the given object which might be modified in
+    # place has been read since its digest has been computed.
+    #
+    # @param  [AbstractObject] object
+    #         The object.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def digest_value_read(object)
+      (@objects_with_read_values ||= {}.compare_by_identity)[object] = true
+    end
+
+    # Discards the digests of the objects whose values, read since their
+    # digest has been computed, have been modified in place.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def refresh_digests
+      return unless objects = @objects_with_read_values
+      @objects_with_read_values = nil
+      objects.each_key(&:refresh_digest)
+    end
+
+    # Records that a value of the given object which might be modified in
+    # place has been read since its ASCII plist representation has been
+    # cached.
+    #
+    # @param  [AbstractObject] object
+    #         The object.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def ascii_plist_value_read(object)
+      (@objects_with_read_plist_values ||= []) << object
+    end
+
+    # Discards the cached ASCII plist representations of the objects whose
+    # values, read since the representations have been cached, have been
+    # modified in place.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def refresh_ascii_plist_caches
+      return unless objects = @objects_with_read_plist_values
+      @objects_with_read_plist_values = nil
+      objects.each(&:refresh_ascii_plist_cache)
+    end
+
+    private
+
+    # Writes the contents yielded to the given block to a temporary file
+    # next to the given file while digesting them, and replaces the file
+    # with it unless the file already has the same contents.
+    #
+    # @param  [String] file
+    #         The path of the file.
+    #
+    # @yieldparam [#<<] output
+    #         The output which receives the contents.
+    #
+    # @return [void]
+    #
+    def write_if_changed(file)
+      temp_file = "#{file}.#{SecureRandom.hex(8)}.tmp"
+      digest = Digest::SHA256.new
+      File.open(temp_file, 'w') { |io| yield StreamingWriter::DigestingOutput.new(io, digest) }
+      if file_digest?(file, digest.digest)
+        File.delete(temp_file)
+      else
+        File.rename(temp_file, file)
+      end
+    ensure
+      File.delete(temp_file) if File.exist?(temp_file)
+    end
+
+    # @param  [String] file
+    #         The path of a file.
+    #
+    # @param  [String] digest
+    #         The binary SHA-256 digest to compare.
+    #
+    # @return [Bool] Whether the file exists and has the given digest. The
+    #         file is read in chunks.
+    #
+    def file_digest?(file, digest)
+      File.file?(file) && Digest::SHA256.file(file).digest == digest
     end
 
     public
@@ -505,7 +1111,8 @@ module Xcodeproj
     #         given ISA.
     #
     def list_by_class(klass)
-      objects.select { |o| o.class == klass }
+      materialize_pending_objects if lazily_loaded?
+      object_index.objects_of_class(klass)
     end
 
     # @return [PBXGroup] the main top-level group.
@@ -540,9 +1147,44 @@ module Xcodeproj
     #         project.
     #
     def files
-      objects.grep(PBXFileReference)
+      list_by_class(PBXFileReference)
+    end
+
+    # @return [Hash{PBXGroup, PBXFileReference => Pathname}] The real path of
+    #         the groups and of the file references of the main group,
+    #         computed in a single traversal of the group hierarchy from the
+    #         main group.
+    #
+    # @note   Each path is computed from the one of its parent, which is
+    #         cached, and the computed paths are cached as well for the
+    #         subsequent calls of `real_path`.
+    #
+    def real_paths
+      paths = {}.compare_by_identity
+      add_real_paths(main_group, paths)
+      paths
+    end
+
+    private
+
+    # Adds the real path of the given group and of its descendants to the
+    # given hash, the one of each group before the ones of its children.
+    #
+    # @return [void]
+    #
+    def add_real_paths(group, paths)
+      paths[group] = group.real_path
+      group.children.each do |child|
+        if child.is_a?(PBXGroup)
+          add_real_paths(child, paths)
+        elsif child.respond_to?(:real_path)
+          paths[child] = child.real_path
+        end
+      end
     end
 
+    public
+
     # Returns the file reference for the given absolute path.
     #
     # @param  [#to_s] absolute_path
@@ -558,9 +1200,8 @@ module Xcodeproj
         raise ArgumentError, "Paths must be absolute #{absolute_path}"
       end
 
-      objects.find do |child|
-        child.isa == 'PBXFileReference' && child.real_path == absolute_pathname
-      end
+      materialize_pending_objects if lazily_loaded?
+      object_index.file_references_with_real_path(absolute_pathname).first
     end
 
     # @return [ObjectList<AbstractTarget>] A list of all the targets in the
@@ -589,8 +1230,11 @@ module Xcodeproj
     #         are embedded in the passed in target
     #
     def embedded_targets_in_native_target(native_target)
-      native_targets.select do |target|
-        host_targets_for_embedded_target(target).any? { |host| host.uuid == native_target.uuid }
+      targets = native_targets
+      return [] unless targets.any? { |target| target.uuid == native_target.uuid }
+      dependency_uuids = native_target.dependencies.map(&:native_target_uuid).to_set
+      targets.select do |target|
+        target.uuid != native_target.uuid && dependency_uuids.include?(target.uuid)
       end
     end
 
@@ -605,10 +1249,30 @@ module Xcodeproj
     #         embedded target
     #
     def host_targets_for_embedded_target(embedded_target)
+      hosts = dependencies_on_target(embedded_target).flat_map do |dependency|
+        dependency.referrers.grep(PBXNativeTarget)
+      end.to_set
+      return [] if hosts.empty?
       native_targets.select do |native_target|
-        ((embedded_target.uuid != native_target.uuid) &&
-         (native_target.dependencies.map(&:native_target_uuid).include? embedded_target.uuid))
+        embedded_target.uuid != native_target.uuid && hosts.include?(native_target)
+      end
+    end
+
+    # Returns the target dependencies whose target is the given one, either
+    # directly or through a container item proxy.
+    #
+    # @param  [AbstractTarget] target
+    #         The target whose dependencies are needed.
+    #
+    # @return [Array<PBXTargetDependency>] The dependencies on the target.
+    #
+    def dependencies_on_target(target)
+      materialize_pending_objects if lazily_loaded?
+      candidates = target.referrers.grep(PBXTargetDependency)
+      object_index.container_item_proxies_with_remote_global_id(target.uuid).each do |proxy|
+        candidates.concat(proxy.referrers.grep(PBXTargetDependency))
       end
+      candidates.uniq.select { |dependency| dependency.native_target_uuid == target.uuid }
     end
 
     # @return [PBXGroup] The group which holds the product file references.
@@ -804,11 +1468,88 @@ module Xcodeproj
     #         the sorting options.
     # @option options [Symbol] :groups_position
     #         the position of the groups can be either `:above` or `:below`.
+    # @option options [Bool] :incremental
+    #         whether to only sort the objects whose order might have changed
+    #         since the last sort of the project with the same options. The
+    #         whole project is sorted if it has not been sorted yet.
+    #
+    # @note   An incremental sort tracks the changes which mark the project
+    #         as dirty. The objects changed without notification, for example
+    #         by mutating the value of an attribute in place, might not be
+    #         sorted.
     #
     # @return [void]
     #
     def sort(options = nil)
-      root_object.sort_recursively(options)
+      options = options ? options.dup : {}
+      incremental = options.delete(:incremental)
+      options = nil if options.empty?
+      @current_transaction.apply_changes if @current_transaction
+      Instrumentation.instrument('project.sort', self) do
+        begin
+          if incremental && @objects_changed_since_sort && @sort_options == options
+            @objects_to_sort = objects_to_sort
+            @sort_build_phases = @objects_changed_since_sort.each_key.any? do |object|
+              object.is_a?(PBXGroup) || object.is_a?(PBXProject)
+            end
+          end
+          root_object.sort_recursively(options)
+        ensure
+          @objects_to_sort = nil
+          @sort_build_phases = false
+        end
+        @sort_options = options
+        @objects_changed_since_sort = {}.compare_by_identity
+      end
+    end
+
+    # @return [Bool] Whether the given object should be sorted by the current
+    #         sort of the project.
+    #
+    # @visibility private
+    #
+    def sort_pending?(object)
+      objects_to_sort = @objects_to_sort
+      objects_to_sort.nil? || objects_to_sort.key?(object) ||
+        (@sort_build_phases && object.is_a?(AbstractBuildPhase))
+    end
+
+    # Records that the given object changed since the last sort of the
+    # project.
+    #
+    # @param  [AbstractObject] object
+    #         The changed object.
+    #
+    # @return [void]
+    #
+    # @visibility private
+    #
+    def mark_changed_since_sort(object)
+      changed = @objects_changed_since_sort
+      changed[object] = true if changed
+    end
+
+    private
+
+    # @return [Hash{AbstractObject => Bool}] The objects whose lists might no
+    #         longer be sorted: the changed objects, which might have new
+    #         members, the objects which list them and the objects which
+    #         list objects whose name depends on them.
+    #
+    # @note   If a group or the project changed, the full paths of the files
+    #         might have changed too, and with them the order of the build
+    #         files, so all the build phases are sorted as well.
+    #
+    def objects_to_sort
+      objects = {}.compare_by_identity
+      @objects_changed_since_sort.each_key do |object|
+        objects[object] = true
+        object.referrers.each do |referrer|
+          objects[referrer] = true
+          referrer.referrers.each { |owner| objects[owner] = true } if referrer.is_a?(AbstractObject)
+        end
+      end
+      objects
     end
 
     public
@@ -834,6 +1575,9 @@ module Xcodeproj
     # Recreates the user schemes of the project from scratch (removes the
     # folder) and optionally hides them.
     #
+    # The schemes are built, and yielded, in the order of the targets and
+    # then they are written concurrently.
+    #
     # @param  [Bool] visible
     #         Whether the schemes should be visible or hidden.
     #
@@ -848,7 +1592,7 @@ module Xcodeproj
       xcschememanagement['SchemeUserState'] = {}
       xcschememanagement['SuppressBuildableAutocreation'] = {}
 
-      targets.each do |target|
+      schemes = targets.map do |target|
         scheme = XCScheme.new
 
         test_target = target if target.respond_to?(:test_target_type?) && target.test_target_type?
@@ -856,15 +1600,45 @@ module Xcodeproj
         scheme.configure_with_targets(target, test_target, :launch_target => launch_target)
 
         yield scheme, target if block_given?
-        scheme.save_as(path, target.name, false)
         xcschememanagement['SchemeUserState']["#{target.name}.xcscheme"] = {}
         xcschememanagement['SchemeUserState']["#{target.name}.xcscheme"]['isShown'] = visible
+        [scheme, target.name]
       end
+      save_user_schemes(schemes)
 
       xcschememanagement_path = schemes_dir + 'xcschememanagement.plist'
       Plist.write_to_path(xcschememanagement, xcschememanagement_path)
     end
 
+    private
+
+    # Saves the given user schemes with a thread per processor.
+    #
+    # @param  [Array<Array(XCScheme, String)>] schemes
+    #         The schemes to save with their names. If several schemes have
+    #         the same name the last one is saved, as if they were saved in
+    #         order.
+    #
+    # @return [void]
+    #
+    def save_user_schemes(schemes)
+      queue = Queue.new
+      Hash[schemes.map(&:reverse)].each { |name, scheme| queue << [scheme, name] }
+      workers = Array.new([queue.size, Etc.nprocessors].min) do
+        Thread.new do
+          until queue.empty?
+            scheme, name = begin
+                             queue.pop(true)
+                           rescue ThreadError
+                             break
+                           end
+            scheme.save_as(path, name, false)
+          end
+        end
+      end
+      workers.each(&:join)
+    end
+
     #-------------------------------------------------------------------------#
   end
 end
@@ -0,0 +1,70 @@
+require 'digest'
+
+module Xcodeproj
+  class Project
+    # Computes the digests of the contents of the objects and of the projects,
+    # see {Object::AbstractObject#digest} and {Project#digest}.
+    #
+    # The values are appended to a binary buffer, which is then digested at
+    # once, in an unambiguous encoding prefixed by their type and their size
+    # which ignores the order of the keys of the hashes: equal plist values,
+    # as compared by `==`, always produce the same digest.
+    #
+    # @visibility private
+    #
+    module ContentDigest
+      # @return [String] A new buffer.
+      #
+      def self.new_buffer
+        String.new.force_encoding(Encoding::BINARY)
+      end
+
+      # Appends the given plist value to the given buffer.
+      #
+      # @param  [String] buffer
+      #         The buffer returned by {new_buffer}.
+      #
+      # @param  [String, Hash, Array, Object] value
+      #         The value.
+      #
+      # @return [String] The buffer.
+      #
+      def self.append(buffer, value)
+        case value
+        when String
+          buffer << 's' << value.bytesize.to_s << ':' << (value.ascii_only? ? value : value.b)
+        when Hash
+          buffer << 'h' << value.size.to_s << ':'
+          value.keys.sort_by(&:to_s).each do |key|
+            append(buffer, key)
+            append(buffer, value[key])
+          end
+        when Array
+          buffer << 'a' << value.size.to_s << ':'
+          value.each { |entry| append(buffer, entry) }
+        else
+          append(buffer << 'o' << value.class.name, value.to_s)
+        end
+        buffer
+      end
+
+      # @param  [String] buffer
+      #         The buffer.
+      #
+      # @return [String] The binary SHA-256 digest of the buffer.
+      #
+      def self.digest(buffer)
+        Digest::SHA256.digest(buffer)
+      end
+
+      # @param  [String] buffer
+      #         The buffer.
+      #
+      # @return [String] The hexadecimal SHA-256 digest of the buffer.
+      #
+      def self.hexdigest(buffer)
+        Digest::SHA256.hexdigest(buffer)
+      end
+    end
+  end
+end
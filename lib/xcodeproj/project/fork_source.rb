@@ -0,0 +1,288 @@
+module Xcodeproj
+  class Project
+    # The objects of a project at the time it has been forked, from which
+    # the fork initializes its objects on demand, see {Project#fork}.
+    #
+    # The source behaves as the `objects` hash of the plist of the project:
+    # the plist of an object is computed from the object of the forked
+    # project the first time it is requested. Before an object of the forked
+    # project is modified for the first time, the project asks the {Store} of
+    # its forks to preserve it, so the objects are always returned as they
+    # were when the project has been forked.
+    #
+    # If the forked project has been opened lazily, the plists of the
+    # objects which it had not initialized yet are read from its pending
+    # plist, which the project asks the {Store} to preserve before it
+    # initializes them.
+    #
+    # The preserved plists are deeply frozen and shared by all the forks
+    # which need them. Every request returns new hashes and arrays, so the
+    # collections of the objects of the fork can be mutated safely, while the
+    # strings are the frozen ones of the preserved plist.
+    #
+    # @visibility private
+    #
+    class ForkSource
+      # @return [Integer] The generation of the fork, which increases with
+      #         every fork of the project.
+      #
+      attr_reader :generation
+
+      # @param  [Project] project
+      #         The forked project.
+      #
+      # @param  [Store] store
+      #         The store of the preserved plists of the project.
+      #
+      # @param  [Integer] generation
+      #         The generation of the fork.
+      #
+      def initialize(project, store, generation)
+        @objects_by_uuid = project.loaded_objects_by_uuid.dup
+        @pending_objects_plist = project.pending_objects_plist
+        @store = store
+        @generation = generation
+      end
+
+      # @param  [String] uuid
+      #         The UUID of an object.
+      #
+      # @return [Boolean] Whether the project had an object with the given
+      #         UUID when it has been forked.
+      #
+      def key?(uuid)
+        @objects_by_uuid.key?(uuid) || pending?(uuid)
+      end
+
+      # @param  [String] uuid
+      #         The UUID of an object.
+      #
+      # @return [Hash] A copy of the plist of the object with the given UUID,
+      #         as it was when the project has been forked.
+      # @return [Nil] If the project had no object with the given UUID.
+      #
+      def [](uuid)
+        if object = @objects_by_uuid[uuid]
+          ForkSource.thaw(@store.plist(object, generation))
+        elsif pending?(uuid)
+          ForkSource.thaw(@store.pending_plist(uuid, @pending_objects_plist))
+        end
+      end
+
+      # @param  [String] uuid
+      #         The UUID of an object.
+      #
+      # @return [Boolean] Whether the object with the given UUID had not been
+      #         initialized by the project when it has been forked.
+      #
+      def pending?(uuid)
+        !@pending_objects_plist.nil? && !@objects_by_uuid.key?(uuid) && @pending_objects_plist.key?(uuid)
+      end
+
+      # @param  [AbstractObject] object
+      #         An object of the forked project.
+      #
+      # @return [Boolean] Whether the project had the given object when it
+      #         has been forked.
+      #
+      def member?(object)
+        @objects_by_uuid[object.uuid].equal?(object)
+      end
+
+      # @return [Array<AbstractObject>] The objects of the project when it has
+      #         been forked.
+      #
+      def objects
+        @objects_by_uuid.values
+      end
+
+      # @param  [Object] value
+      #         A plist value.
+      #
+      # @return [Object] A deeply frozen copy of the given value, which
+      #         shares the strings which are already frozen.
+      #
+      def self.freeze_value(value)
+        case value
+        when String
+          -value
+        when Hash
+          value.each_with_object({}) { |(key, entry), hash| hash[freeze_value(key)] = freeze_value(entry) }.freeze
+        when Array
+          value.map { |entry| freeze_value(entry) }.freeze
+        else
+          value
+        end
+      end
+
+      # @param  [Object] value
+      #         A value returned by {freeze_value}.
+      #
+      # @return [Object] A copy of the given value with new hashes and
+      #         arrays, which shares the frozen strings.
+      #
+      def self.thaw(value)
+        case value
+        when Hash
+          value.each_with_object({}) { |(key, entry), hash| hash[key] = thaw(entry) }
+        when Array
+          value.map { |entry| thaw(entry) }
+        else
+          value
+        end
+      end
+
+      # The plists of the objects of a project preserved for all its live
+      # forks.
+      #
+      # The plists of an object are stored as a list of versions, each one
+      # valid for the forks whose generation is greater than the one of the
+      # previous version and up to its own. So an object is preserved once
+      # for all the forks created since it has last been modified, however
+      # many there are.
+      #
+      class Store
+        # A version of the plist of an object, which is current if the
+        # object has not been modified since it has been computed.
+        #
+        Version = Struct.new(:generation, :plist, :current)
+
+        # @param  [Project] project
+        #         The forked project.
+        #
+        def initialize(project)
+          @project = project
+          @sources = ObjectSpace::WeakMap.new
+          @generation = 0
+          @versions = {}.compare_by_identity
+          @pending_plists = {}
+        end
+
+        # @return [ForkSource] The source of a new fork of the project.
+        #
+        def new_source
+          prune
+          @generation += 1
+          source = ForkSource.new(@project, self, @generation)
+          @sources[source] = source
+        end
+
+        # @param  [AbstractObject] object
+        #         An object of the forked project.
+        #
+        # @param  [Integer] generation
+        #         The generation of the fork which requests the plist.
+        #
+        # @return [Hash] The frozen plist of the given object for the forks
+        #         of the given generation.
+        #
+        def plist(object, generation)
+          versions = (@versions[object] ||= [])
+          version = versions.find { |candidate| candidate.generation >= generation }
+          unless version
+            version = versions.last
+            if version && version.current
+              version.generation = @generation
+            else
+              version = Version.new(@generation, frozen_plist(object), true)
+              versions << version
+            end
+          end
+          version.plist
+        end
+
+        # Records the plist of the given object, unless it has already been
+        # recorded for all the forks which had the object, as the object is
+        # about to be modified.
+        #
+        # @param  [AbstractObject] object
+        #         An object of the forked project.
+        #
+        # @return [void]
+        #
+        def preserve(object)
+          versions = @versions[object]
+          last = versions && versions.last
+          if last && last.current
+            last.generation = @generation
+            last.current = false
+            return
+          end
+          return if last && last.generation == @generation
+          previous_generation = last ? last.generation : 0
+          return unless @sources.keys.any? { |source| source.generation > previous_generation && source.member?(object) }
+          (@versions[object] ||= []) << Version.new(@generation, frozen_plist(object), false)
+        end
+
+        # @param  [String] uuid
+        #         The UUID of an object which had not been initialized by the
+        #         forked project when the fork has been created.
+        #
+        # @param  [Hash, ForkSource] objects_plist
+        #         The pending plist of the objects of the forked project.
+        #
+        # @return [Hash] The frozen plist of the object with the given UUID.
+        #
+        def pending_plist(uuid, objects_plist)
+          @pending_plists[uuid] ||= ForkSource.freeze_value(objects_plist[uuid])
+        end
+
+        # Records the plist from which the forked project is about to
+        # initialize an object, unless no live fork needs it, as the values
+        # of the object might then be modified in place.
+        #
+        # @param  [String] uuid
+        #         The UUID of the object.
+        #
+        # @param  [Hash] plist
+        #         The plist of the object.
+        #
+        # @return [void]
+        #
+        def preserve_pending(uuid, plist)
+          return if @pending_plists.key?(uuid)
+          return unless @sources.keys.any? { |source| source.pending?(uuid) }
+          @pending_plists[uuid] = ForkSource.freeze_value(plist)
+        end
+
+        # Records the plists of all the objects of the live forks which have
+        # not been recorded yet, for example before the UUIDs of the forked
+        # project are changed.
+        #
+        # @return [void]
+        #
+        def preserve_all
+          @sources.each_key { |source| source.objects.each { |object| preserve(object) } }
+        end
+
+        private
+
+        # @return [Hash] The deeply frozen plist of the given object, whose
+        #         relationships are initialized first if the forked project
+        #         has been opened lazily.
+        #
+        def frozen_plist(object)
+          @project.materialize_object(object)
+          @project.preserving_for_forks { ForkSource.freeze_value(object.to_hash) }
+        end
+
+        # Drops the versions which are only valid for forks which are no
+        # longer alive.
+        #
+        # @return [void]
+        #
+        def prune
+          generation = @sources.keys.map(&:generation).min
+          unless generation
+            @pending_plists.clear
+            return @versions.clear
+          end
+          @versions.delete_if do |_, versions|
+            versions.reject! { |version| version.generation < generation }
+            versions.empty?
+          end
+        end
+      end
+    end
+  end
+end
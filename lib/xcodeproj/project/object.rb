@@ -62,7 +62,7 @@ module Xcodeproj
           @project = project
           @uuid = uuid
           @isa = self.class.isa
-          @referrers = []
+          @referrers = {}.compare_by_identity
           unless @isa =~ /^(PBX|XC)/
             raise "[Xcodeproj] Attempt to initialize an abstract class (#{self.class})."
           end
@@ -101,6 +101,7 @@ module Xcodeproj
         def remove_from_project
           mark_project_as_dirty!
           project.objects_by_uuid.delete(uuid)
+          project.object_index.object_removed(self)
 
           referrers.dup.each do |referrer|
             referrer.remove_reference(self)
@@ -146,9 +147,7 @@ module Xcodeproj
         def sort(_options = nil)
           to_many_attributes.each do |attrb|
             list = attrb.get_value(self)
-            list.sort! do |x, y|
-              x.display_name.downcase <=> y.display_name.downcase
-            end
+            list.sort_by_keys! { |object| object.display_name.downcase }
           end
         end
 
@@ -169,6 +168,10 @@ module Xcodeproj
         #         At the time of writing the only known case is
         #         `PBXTargetDependency`.
         #
+        # @note   During an incremental sort of the project only the objects
+        #         whose order might have changed are sorted, see
+        #         {#sort_pending?}.
+        #
         def sort_recursively(options = nil)
           to_one_attributes.each do |attrb|
             value = attrb.get_value(self)
@@ -180,7 +183,16 @@ module Xcodeproj
             list.each { |entry| entry.sort_recursively(options) }
           end
 
-          sort(options)
+          sort(options) if sort_pending?
+        end
+
+        # @return [Bool] Whether the object should be sorted by the current
+        #         sort of the project.
+        #
+        # @visibility private
+        #
+        def sort_pending?
+          project.sort_pending?(self)
         end
 
         # @!group Reference counting
@@ -188,36 +200,69 @@ module Xcodeproj
         # @return [Array<ObjectList>] The list of the objects that have a
         #   reference to this object.
         #
+        # @note If the project has been opened lazily, the pending objects are
+        #   initialized first as any of them might reference this object.
+        #
+        # @visibility private
+        #
+        def referrers
+          @project.materialize_pending_objects if @project.lazily_loaded?
+          @referrers.keys
+        end
+
+        # @param  [AbstractObject, Project] object
+        #         The object to check.
+        #
+        # @return [Boolean] Whether the given object references this one.
+        #
         # @visibility private
         #
-        attr_reader :referrers
+        def referenced_by?(object)
+          @project.materialize_pending_objects if @project.lazily_loaded?
+          @referrers.key?(object)
+        end
 
         # Informs the object that another object is referencing it. If the
         # object had no previous references it is added to the project UUIDs
         # hash.
         #
+        # @note The referrers are stored as the keys of a hash comparing by
+        #       identity, which keeps the insertion order and makes both adding
+        #       and removing a referrer constant time operations.
+        #
         # @return [void]
         #
         # @visibility private
         #
         def add_referrer(referrer)
-          @referrers << referrer
-          @project.objects_by_uuid[uuid] = self
+          transaction = @project.current_transaction
+          transaction.journal(self) if transaction
+          @referrers[referrer] = true
+          @project.loaded_objects_by_uuid[uuid] = self
+          @project.object_index.object_added(self)
         end
 
         # Informs the object that another object stopped referencing it. If the
         # object has no other references it is removed from the project UUIDs
         # hash because it is unreachable.
         #
+        # @note All the references of the given referrer are dropped at once.
+        #
         # @return [void]
         #
         # @visibility private
         #
         def remove_referrer(referrer)
+          @project.materialize_pending_objects if @project.lazily_loaded?
+          transaction = @project.current_transaction
+          transaction.journal(self) if transaction
           @referrers.delete(referrer)
-          if @referrers.count == 0
+          if @referrers.empty?
             mark_project_as_dirty!
             @project.objects_by_uuid.delete(uuid)
+            @project.object_index.object_removed(self)
+          else
+            @project.object_index.referrers_changed(self)
           end
         end
 
@@ -244,14 +289,107 @@ module Xcodeproj
           end
         end
 
-        # Marks the project that this object belongs to as having been modified.
+        # Removes all the references to the given objects, visiting each
+        # relationship of the receiver only once.
+        #
+        # @param  [Hash{AbstractObject => Boolean}] objects
+        #         The objects to remove, as a hash comparing by identity.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def remove_references(objects)
+          to_one_attributes.each do |attrb|
+            value = attrb.get_value(self)
+            attrb.set_value(self, nil) if value && objects.key?(value)
+          end
+
+          to_many_attributes.each do |attrb|
+            list = attrb.get_value(self)
+            list.delete_objects(objects)
+          end
+
+          references_by_keys_attributes.each do |attrb|
+            list = attrb.get_value(self)
+            list.each { |dictionary| dictionary.remove_references(objects) }
+          end
+        end
+
+        # Marks the project that this object belongs to as having been modified
+        # and discards the cached serialization of the object.
+        #
+        # @note   While a transaction is in progress, the state of the object is
+        #         recorded instead and the bookkeeping is deferred, see
+        #         {Project#transaction}.
+        #
+        # @note   The object is recorded for the forks of the project before
+        #         anything else, see {Project#fork}.
+        #
+        # @note   The digest of the object is discarded immediately, even
+        #         during a transaction, see {#digest}.
         #
         # @return [void]
         #
         # @visibility private
         #
         def mark_project_as_dirty!
+          project.preserve_for_forks(self)
+          invalidate_digest
+          transaction = project.current_transaction
+          return transaction.object_changed(self) if transaction
+          invalidate_ascii_plist_cache
           project.mark_dirty!
+          project.mark_changed_since_sort(self)
+        end
+
+        # @return [Array] The state of the attributes and of the referrers of
+        #         the object, which can be restored by {#restore_state}.
+        #
+        # @note   The simple attributes are deep copied, as their values might
+        #         be modified in place.
+        #
+        # @visibility private
+        #
+        def capture_state
+          [
+            @simple_attributes_hash && Marshal.dump(@simple_attributes_hash),
+            to_one_attributes.map { |attrb| instance_variable_get(:"@#{attrb.name}") },
+            to_many_attributes.map { |attrb| instance_variable_get(:"@#{attrb.name}").to_a },
+            references_by_keys_attributes.map do |attrb|
+              instance_variable_get(:"@#{attrb.name}").to_a.map { |dictionary| [dictionary, {}.merge(dictionary)] }
+            end,
+            @referrers.dup,
+          ]
+        end
+
+        # Restores the state returned by {#capture_state}, without informing
+        # the other objects, whose state is expected to be restored as well.
+        #
+        # @param  [Array] state
+        #         The state to restore.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def restore_state(state)
+          simple_attributes, to_one_values, to_many_values, references_by_keys_values, referrers = state
+          @simple_attributes_hash = simple_attributes && Marshal.load(simple_attributes)
+          to_one_attributes.zip(to_one_values) do |attrb, value|
+            instance_variable_set(:"@#{attrb.name}", value)
+          end
+          to_many_attributes.zip(to_many_values) do |attrb, objects|
+            list = instance_variable_get(:"@#{attrb.name}")
+            Array.instance_method(:replace).bind(list).call(objects) if list
+          end
+          references_by_keys_attributes.zip(references_by_keys_values) do |attrb, entries|
+            list = instance_variable_get(:"@#{attrb.name}")
+            next unless list
+            Array.instance_method(:replace).bind(list).call(entries.map(&:first))
+            entries.each { |dictionary, contents| dictionary.replace(contents) }
+          end
+          @referrers = referrers
         end
 
         #---------------------------------------------------------------------#
@@ -271,19 +409,41 @@ module Xcodeproj
         # @visibility private
         #
         def configure_with_plist(objects_by_uuid_plist)
-          object_plist = objects_by_uuid_plist[uuid].dup
+          object_plist = objects_by_uuid_plist[uuid]
 
           unless object_plist['isa'] == isa
             raise "[Xcodeproj] Attempt to initialize `#{isa}` from plist with " \
               "different isa `#{object_plist}`"
           end
-          object_plist.delete('isa')
 
           simple_attributes.each do |attrb|
             attrb.set_value(self, object_plist[attrb.plist_name])
-            object_plist.delete(attrb.plist_name)
           end
 
+          if project.defer_object_relationships(self)
+            @relationships_pending = true
+          else
+            configure_relationships_with_plist(objects_by_uuid_plist)
+          end
+        end
+
+        # Configures the relationships of the object with the objects hash
+        # from a plist, initializing the referenced objects if needed.
+        #
+        # @note For projects opened lazily this is performed by
+        #       {Project#materialize_object} the first time a relationship of
+        #       the object is accessed.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def configure_relationships_with_plist(objects_by_uuid_plist)
+          @relationships_pending = false
+          object_plist = objects_by_uuid_plist[uuid].dup
+          object_plist.delete('isa')
+          simple_attributes.each { |attrb| object_plist.delete(attrb.plist_name) }
+
           to_one_attributes.each do |attrb|
             ref_uuid = object_plist[attrb.plist_name]
             if ref_uuid
@@ -296,10 +456,8 @@ module Xcodeproj
           to_many_attributes.each do |attrb|
             ref_uuids = object_plist[attrb.plist_name] || []
             list = attrb.get_value(self)
-            ref_uuids.each do |uuid|
-              ref = object_with_uuid(uuid, objects_by_uuid_plist, attrb)
-              list << ref if ref
-            end
+            refs = ref_uuids.map { |uuid| object_with_uuid(uuid, objects_by_uuid_plist, attrb) }
+            list.concat(refs.compact)
             object_plist.delete(attrb.plist_name)
           end
 
@@ -347,7 +505,7 @@ module Xcodeproj
         # @visibility private
         #
         def object_with_uuid(uuid, objects_by_uuid_plist, attribute)
-          unless object = project.objects_by_uuid[uuid] || project.new_from_plist(uuid, objects_by_uuid_plist)
+          unless object = project.loaded_objects_by_uuid[uuid] || project.new_from_plist(uuid, objects_by_uuid_plist)
             UI.warn "`#{inspect}` attempted to initialize an object with " \
               "an unknown UUID. `#{uuid}` for attribute: " \
               "`#{attribute.name}`. This can be the result of a merge and " \
@@ -421,6 +579,209 @@ module Xcodeproj
           Nanaimo::Dictionary.new(to_hash_as(:to_ascii_plist), ascii_plist_annotation)
         end
 
+        # @!group Serialization cache
+
+        # @return [Nanaimo::Dictionary] The ASCII plist representation of the
+        #         object, without annotation, stored by {#cache_ascii_plist}.
+        # @return [Nil] If the representation has not been cached or if the
+        #         object changed since it was.
+        #
+        # @note   Besides the mutations which mark the project as dirty, the
+        #         values which might be modified in place (e.g. the build
+        #         settings hash) are checked again only if they have been read
+        #         through their accessor since the representation has been
+        #         cached, see {Project#refresh_ascii_plist_caches}, which is
+        #         expected to be called before serializing the objects.
+        #
+        # @visibility private
+        #
+        def cached_ascii_plist
+          @ascii_plist_cache
+        end
+
+        # Caches the ASCII plist representation of the object.
+        #
+        # @note   The representation can be cached only once the one of every
+        #         object referenced by this one is cached, see
+        #         {#invalidate_ascii_plist_cache}. For this reason {Project}
+        #         caches the objects only after serializing all of them.
+        #
+        # @param  [Nanaimo::Dictionary] plist
+        #         The representation returned by {#to_ascii_plist}.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def cache_ascii_plist(plist)
+          @ascii_plist_cache = plist if cache_ascii_plist?
+        end
+
+        # Discards the cached ASCII plist representation of the object and of
+        # the objects which reference it, as their representation includes
+        # the annotation of this object.
+        #
+        # @note   The propagation stops at the objects without a cached
+        #         representation because their referrers are not cached
+        #         either.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def invalidate_ascii_plist_cache
+          @ascii_plist_attributes_digest = nil
+          return unless @ascii_plist_cache
+          @ascii_plist_cache = nil
+          @referrers.each_key do |referrer|
+            referrer.invalidate_ascii_plist_cache if referrer.is_a?(AbstractObject)
+          end
+        end
+
+        # Records the digest of the simple attributes of the object, as one of
+        # their values which might be modified in place is about to be read
+        # while the representation of the object is cached.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def ascii_plist_value_read
+          return if @ascii_plist_attributes_digest
+          @ascii_plist_attributes_digest = attributes_digest
+          project.ascii_plist_value_read(self)
+        end
+
+        # Discards the cached ASCII plist representation of the object if its
+        # simple attributes have been modified in place since they have been
+        # read, see {#ascii_plist_value_read}.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def refresh_ascii_plist_cache
+          return unless digest = @ascii_plist_attributes_digest
+          @ascii_plist_attributes_digest = nil
+          invalidate_ascii_plist_cache if digest != attributes_digest
+        end
+
+        # @return [Bool] Whether the ASCII plist representation of the object
+        #         depends only on the object and on the objects which it
+        #         references and thus can be cached.
+        #
+        # @visibility private
+        #
+        def cache_ascii_plist?
+          true
+        end
+
+        # @!group Content digest
+
+        # @return [String] The digest of the contents of the object, which
+        #         combines its UUID and its simple attributes with the digests
+        #         of the objects it references, so it changes whenever the
+        #         object or any object reachable from it changes.
+        #
+        # @note   The digest is cached until the object, or one of the objects
+        #         whose digest it includes, is modified (see
+        #         {#invalidate_digest}). As for transactions, the values which
+        #         might be modified in place (e.g. the build settings hash) are
+        #         checked again only if they have been read through their
+        #         accessor since the digest has been computed (see
+        #         {#refresh_digest}), so they should not be retained and
+        #         modified later.
+        #
+        def digest
+          project.refresh_digests
+          @digest ||= begin
+            @attributes_digest = attributes_digest
+            buffer = ContentDigest.new_buffer << @attributes_digest
+
+            to_one_attributes.each do |attrb|
+              obj = attrb.get_value(self)
+              ContentDigest.append(ContentDigest.append(buffer, attrb.plist_name), to_one_digest(attrb, obj)) if obj
+            end
+
+            to_many_attributes.each do |attrb|
+              list = attrb.get_value(self)
+              ContentDigest.append(ContentDigest.append(buffer, attrb.plist_name), list.map(&:digest))
+            end
+
+            references_by_keys_attributes.each do |attrb|
+              list = attrb.get_value(self)
+              digests = list.map do |dictionary|
+                dictionary.each_with_object({}) { |(key, obj), hash| hash[key.to_s] = obj.digest if obj }
+              end
+              ContentDigest.append(ContentDigest.append(buffer, attrb.plist_name), digests)
+            end
+
+            ContentDigest.hexdigest(buffer)
+          end
+        end
+
+        # Discards the digest of the object and of the objects which reference
+        # it, as their digest might include the one of this object.
+        #
+        # @note   The propagation stops at the objects without a digest because
+        #         the digests of their referrers have been discarded as well.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def invalidate_digest
+          return unless @digest
+          @digest = nil
+          @referrers.each_key do |referrer|
+            referrer.invalidate_digest if referrer.is_a?(AbstractObject)
+          end
+        end
+
+        # Discards the digest of the object if its simple attributes have been
+        # modified in place since the digest has been computed.
+        #
+        # @return [void]
+        #
+        # @visibility private
+        #
+        def refresh_digest
+          invalidate_digest if @digest && @attributes_digest != attributes_digest
+        end
+
+        private
+
+        # @param  [AbstractObjectAttribute] attrb
+        #         The to-one attribute.
+        #
+        # @param  [AbstractObject] obj
+        #         The object referenced by the attribute.
+        #
+        # @return [String] The contribution of the given object to the digest
+        #         of this one.
+        #
+        def to_one_digest(_attrb, obj)
+          obj.digest
+        end
+
+        # @return [String] The digest of the ISA, of the UUID and of the simple
+        #         attributes of the object.
+        #
+        def attributes_digest
+          buffer = ContentDigest.new_buffer
+          ContentDigest.append(buffer, isa)
+          ContentDigest.append(buffer, uuid)
+          simple_attributes.each do |attrb|
+            value = @simple_attributes_hash[attrb.plist_name] if @simple_attributes_hash
+            ContentDigest.append(ContentDigest.append(buffer, attrb.plist_name), value) if value
+          end
+          ContentDigest.digest(buffer)
+        end
+
+        public
+
+        # @!group Plist related methods
+
         # Returns a cascade representation of the object without UUIDs.
         #
         # This method is designed to work in conjunction with
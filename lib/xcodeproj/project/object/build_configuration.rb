@@ -12,6 +12,25 @@ module Xcodeproj
 
         private_constant :MUTUAL_RECURSION_SENTINEL
 
+        # The state shared by the resolution of a build setting and of the
+        # build settings it references.
+        #
+        # values:      the resolved values by configuration UUID, key and
+        #              previous key.
+        # in_progress: the resolutions which are being computed, used to
+        #              detect cycles.
+        # configs:     the contents of the configuration files.
+        # cycles:      the number of cycles detected.
+        # env:         the values of the environment variables which have
+        #              been read.
+        #
+        Resolution = Struct.new(:values, :in_progress, :configs, :cycles, :env) do
+          def initialize(env = {})
+            super({}, {}, {}.compare_by_identity, 0, env)
+          end
+        end
+        private_constant :Resolution
+
         # @!group Attributes
 
         # @return [String] the name of the configuration.
@@ -73,6 +92,17 @@ module Xcodeproj
           self.build_settings = sorted_build_settings
         end
 
+        # @return [Bool] Whether the configuration should be sorted by the
+        #         current sort of the project. Always true as the build
+        #         settings are usually edited in place, which does not mark
+        #         the configuration as changed.
+        #
+        # @visibility private
+        #
+        def sort_pending?
+          true
+        end
+
         # @return [Boolean] Whether this configuration is configured for
         #         debugging.
         #
@@ -107,20 +137,103 @@ module Xcodeproj
         # @return [String] The value of the build setting
         #
         def resolve_build_setting(key, root_target = nil, previous_key = nil)
-          setting = build_settings[key]
-          setting = resolve_variable_substitution(key, setting, root_target, previous_key)
+          resolve_build_setting_with_cache(key, root_target, previous_key, Resolution.new)
+        end
+
+        # Gets the values of the given build settings, as
+        # {#resolve_build_setting} would do for each of them, resolving each
+        # build setting referenced by their values only once.
+        #
+        # @param [Array<String>] keys
+        #        the keys of the build settings.
+        #
+        # @param [PBXNativeTarget] root_target
+        #        use this to resolve complete recursion between project and targets.
+        #
+        # @param [Hash{String => String}] env
+        #        the hash which receives the values of the environment
+        #        variables read by the resolution.
+        #
+        # @return [Hash{String => String}] The values of the build settings
+        #         which are not nil.
+        #
+        def resolve_build_settings(keys, root_target = nil, env = {})
+          resolution = Resolution.new(env)
+          keys.each_with_object({}) do |key, result|
+            value = resolve_build_setting_with_cache(key, root_target, nil, resolution)
+            result[key] = value unless value.nil?
+          end
+        end
+
+        # @return [Array<String>] the keys of the build settings defined by
+        #         this configuration or by its configuration file.
+        #
+        def build_setting_keys
+          resolution_build_settings.keys | config.keys
+        end
+
+        # @return [Array] the values on which the resolution of the build
+        #         settings of this configuration depends, besides the
+        #         environment variables and the other configurations.
+        #
+        # @note   The attributes and the build settings of the configuration
+        #         are represented by its {#digest}, which is cached until the
+        #         configuration is modified or its build settings are read
+        #         through their accessor, so the stamp of an unchanged
+        #         configuration doesn't depend on the number of its settings.
+        #
+        # @visibility private
+        #
+        def build_settings_resolution_stamp
+          [digest, project.project_dir, config_stamp]
+        end
+
+        #---------------------------------------------------------------------#
+
+        protected
+
+        # Implements {#resolve_build_setting}, memoizing the values of the
+        # build settings in the given resolution.
+        #
+        # @note  Resolving again a build setting which is being resolved with
+        #        the same arguments would never end. Such cycles are treated
+        #        as the mutual recursion between two build settings. The
+        #        values computed while a cycle was broken depend on where the
+        #        resolution started, so they are not memoized.
+        #
+        def resolve_build_setting_with_cache(key, root_target, previous_key, resolution)
+          cache_key = [uuid, key, previous_key]
+          return resolution.values[cache_key] if resolution.values.key?(cache_key)
+          if resolution.in_progress.key?(cache_key)
+            resolution.cycles += 1
+            return MUTUAL_RECURSION_SENTINEL
+          end
+
+          resolution.in_progress[cache_key] = true
+          cycles = resolution.cycles
+          value = compute_build_setting(key, root_target, previous_key, resolution)
+          resolution.in_progress.delete(cache_key)
+          resolution.values[cache_key] = value if resolution.cycles == cycles
+          value
+        end
+
+        private
 
-          config_setting = config[key]
-          config_setting = resolve_variable_substitution(key, config_setting, root_target, previous_key)
+        def compute_build_setting(key, root_target, previous_key, resolution)
+          setting = resolution_build_settings[key]
+          setting = resolve_variable_substitution(key, setting, root_target, resolution, previous_key)
+
+          config_setting = (resolution.configs[self] ||= config)[key]
+          config_setting = resolve_variable_substitution(key, config_setting, root_target, resolution, previous_key)
 
           project_setting = project.build_configuration_list[name]
           project_setting = nil if equal?(project_setting)
-          project_setting &&= project_setting.resolve_build_setting(key, root_target)
+          project_setting &&= project_setting.resolve_build_setting_with_cache(key, root_target, nil, resolution)
 
-          defaults = {
-            'CONFIGURATION' => name,
-            'SRCROOT' => project.project_dir.to_s,
-          }
+          default = case key
+                    when 'CONFIGURATION' then name
+                    when 'SRCROOT' then project.project_dir.to_s
+                    end
 
           # if previous_key is nil, it means that we're back at the first call, so we can replace our sentinel string
           # used to prevent recursion with nil
@@ -128,15 +241,12 @@ module Xcodeproj
             setting = nil
           end
 
-          [defaults[key], project_setting, config_setting, setting, ENV[key]].compact.reduce(nil) do |inherited, value|
+          env_setting = resolution.env.fetch(key) { resolution.env[key] = ENV[key] }
+          [default, project_setting, config_setting, setting, env_setting].compact.reduce(nil) do |inherited, value|
             expand_build_setting(value, inherited)
           end
         end
 
-        #---------------------------------------------------------------------#
-
-        private
-
         VARIABLE_NAME_PATTERN =
           '( # capture block
             [_a-zA-Z0-9]+? # non-greedy lookup for everything contained in this list
@@ -167,14 +277,14 @@ module Xcodeproj
           default = build_setting_value.is_a?(String) ? '' : []
           inherited = config_value || default
 
-          return build_setting_value.gsub(Regexp.union(Constants::INHERITED_KEYWORDS), inherited) if build_setting_value.is_a? String
+          return build_setting_value.gsub(Constants::INHERITED_KEYWORDS_REGEXP, inherited) if build_setting_value.is_a? String
           build_setting_value.flat_map { |value| Constants::INHERITED_KEYWORDS.include?(value) ? inherited : value }
         end
 
-        def resolve_variable_substitution(key, value, root_target, previous_key = nil)
+        def resolve_variable_substitution(key, value, root_target, resolution, previous_key = nil)
           case value
           when Array
-            return value.map { |v| resolve_variable_substitution(key, v, root_target) }
+            return value.map { |v| resolve_variable_substitution(key, v, root_target, resolution) }
           when nil
             return
           when String
@@ -203,7 +313,7 @@ module Xcodeproj
             MUTUAL_RECURSION_SENTINEL
           else
             configuration_to_resolve_against = root_target ? root_target.build_configuration_list[name] : self
-            resolved_value_for_variable = configuration_to_resolve_against.resolve_build_setting(variable, root_target, key) || ''
+            resolved_value_for_variable = configuration_to_resolve_against.resolve_build_setting_with_cache(variable, root_target, key, resolution) || ''
 
             # we use this sentinel string instead of nil, because, otherwise, it would be swallowed by the default empty
             # string from the preceding line, and we want to distinguish between mutual recursion and other cases
@@ -212,7 +322,7 @@ module Xcodeproj
             end
 
             value = value.gsub(variable_reference, resolved_value_for_variable)
-            resolve_variable_substitution(key, value, root_target)
+            resolve_variable_substitution(key, value, root_target, resolution)
           end
         end
 
@@ -252,14 +362,39 @@ module Xcodeproj
 
         def config
           return {} unless base_configuration_reference
-          @config ||=
-            if base_configuration_reference.real_path.exist?
-              Xcodeproj::Config.new(base_configuration_reference.real_path).to_hash.tap do |hash|
-                normalize_array_settings(hash)
+          stamp = config_stamp
+          unless @config && @config_stamp == stamp
+            @config_stamp = stamp
+            @config =
+              if stamp[1]
+                Xcodeproj::Config.new(base_configuration_reference.real_path).to_hash.tap do |hash|
+                  normalize_array_settings(hash)
+                end
+              else
+                {}
               end
-            else
-              {}
-            end
+          end
+          @config
+        end
+
+        # @return [Hash] the build settings, read without going through their
+        #         accessor, which would consider them modified in place (see
+        #         {AbstractObject#digest}), as the resolution only reads them.
+        #
+        def resolution_build_settings
+          (@simple_attributes_hash && @simple_attributes_hash['buildSettings']) || {}
+        end
+
+        # @return [Array] the path, modification date and size of the
+        #         configuration file, so that it is read again when it
+        #         changes.
+        # @return [Nil] if there is no configuration file.
+        #
+        def config_stamp
+          return unless base_configuration_reference
+          real_path = base_configuration_reference.real_path
+          stat = real_path.stat if real_path.exist?
+          [real_path, stat && stat.mtime, stat && stat.size]
         end
 
         #---------------------------------------------------------------------#
@@ -69,7 +69,9 @@ module Xcodeproj
         #         file reference if one exists.
         #
         def build_file(file_ref)
-          (file_ref.referrers & files).first
+          file_ref.referrers.find do |referrer|
+            referrer.is_a?(PBXBuildFile) && referrer.referenced_by?(self)
+          end
         end
 
         # Returns whether a build file for the given file reference exists.
@@ -155,17 +157,29 @@ module Xcodeproj
         # @return [void]
         #
         def sort(_options = nil)
-          files.sort! do |x, y|
-            result = File.basename(x.display_name.downcase, '.*') <=> File.basename(y.display_name.downcase, '.*')
-            if result.zero?
-              result = File.extname(x.display_name.downcase) <=> File.extname(y.display_name.downcase)
-              if result.zero? && x.file_ref.respond_to?(:full_path) && y.file_ref.respond_to?(:full_path)
-                result = x.file_ref.full_path.to_s.downcase <=> y.file_ref.full_path.to_s.downcase
-              end
+          files.sort_by_keys!(BUILD_FILES_COMPARATOR) do |build_file|
+            name = build_file.display_name.downcase
+            [File.basename(name, '.*'), File.extname(name), build_file.file_ref]
+          end
+        end
+
+        # @return [Proc] The comparison of the sort keys of two build files.
+        #         The full paths of the files are only computed to order
+        #         the files with the same name.
+        #
+        BUILD_FILES_COMPARATOR = lambda do |x, y|
+          result = x[0] <=> y[0]
+          if result.zero?
+            result = x[1] <=> y[1]
+            if result.zero? && x[2].respond_to?(:full_path) && y[2].respond_to?(:full_path)
+              x[3] ||= x[2].full_path.to_s.downcase
+              y[3] ||= y[2].full_path.to_s.downcase
+              result = x[3] <=> y[3]
             end
-            result
           end
+          result
         end
+        private_constant :BUILD_FILES_COMPARATOR
       end
 
       #-----------------------------------------------------------------------#
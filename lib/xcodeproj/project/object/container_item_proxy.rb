@@ -110,6 +110,13 @@ module Xcodeproj
         def ascii_plist_annotation
           " #{isa} "
         end
+
+        # The annotation of the container portal depends on the real path of
+        # the referenced project, which is not tracked by the cache.
+        #
+        def cache_ascii_plist?
+          false
+        end
       end
     end
   end
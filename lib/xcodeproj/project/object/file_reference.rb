@@ -276,10 +276,8 @@ module Xcodeproj
         #         the external Xcode project.
         #
         def proxy_containers
-          project.objects.select do |object|
-            object.isa == 'PBXContainerItemProxy' &&
-              object.container_portal == uuid
-          end
+          project.materialize_pending_objects if project.lazily_loaded?
+          project.object_index.container_item_proxies_with_portal(uuid)
         end
 
         # If this file reference represents an external Xcode project reference
@@ -290,15 +288,11 @@ module Xcodeproj
         #         items located in the external Xcode project.
         #
         def file_reference_proxies
-          containers = proxy_containers
-          if containers.empty?
-            []
-          else
-            project.objects.select do |object|
-              object.isa == 'PBXReferenceProxy' &&
-                containers.include?(object.remote_ref)
+          proxy_containers.flat_map do |container|
+            container.referrers.select do |object|
+              object.isa == 'PBXReferenceProxy' && object.remote_ref.equal?(container)
             end
-          end
+          end.uniq
         end
 
         # If this file reference represents an external Xcode project reference
@@ -309,15 +303,11 @@ module Xcodeproj
         #         located in the external Xcode project.
         #
         def target_dependency_proxies
-          containers = proxy_containers
-          if containers.empty?
-            []
-          else
-            project.objects.select do |object|
-              object.isa == 'PBXTargetDependency' &&
-                containers.include?(object.target_proxy)
+          proxy_containers.flat_map do |container|
+            container.referrers.select do |object|
+              object.isa == 'PBXTargetDependency' && object.target_proxy.equal?(container)
             end
-          end
+          end.uniq
         end
 
         # In addition to removing the file reference, this will also remove any
@@ -41,6 +41,17 @@ module Xcodeproj
         def display_name
           "Exceptions for \"#{GroupableHelper.parent(self).display_name}\" folder in \"#{target.name}\" target"
         end
+
+        # @note This override is necessary because the target references the
+        #       exception set through its synchronized groups, so the target
+        #       contributes only its UUID.
+        #
+        # @see AbstractObject#digest
+        #
+        def to_one_digest(attrb, obj)
+          attrb.name == :target ? obj.uuid : super
+        end
+        private :to_one_digest
       end
 
       # This class represents a file system synchronized group build phase membership exception set.
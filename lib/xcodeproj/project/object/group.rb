@@ -157,7 +157,11 @@ module Xcodeproj
         # of the source tree) matches the give path.
         #
         def find_file_by_path(path)
-          files.find { |ref| ref.path == path }
+          return files.find { |ref| ref.path == path } if path.nil? || project.lazily_loaded?
+          candidates = project.object_index.file_references_with_name(File.basename(path)).select do |ref|
+            ref.path == path && ref.referrers.include?(self)
+          end
+          candidates.count > 1 ? candidates.min_by { |ref| children.index(ref) } : candidates.first
         end
 
         # @return [Array<PBXGroup>] the groups in the group children.
@@ -224,6 +228,23 @@ module Xcodeproj
         end
         alias_method :new_file, :new_reference
 
+        # Creates the references of the given paths in a single pass, adding
+        # each of them to the subgroup matching its directory, which is
+        # created if needed. The references are configured according to the
+        # extension of their path.
+        #
+        # @param  [Array<#to_s>] paths
+        #         The paths of the references, either absolute or relative to
+        #         the real path of the group.
+        #
+        # @return [Array<PBXFileReference, XCVersionGroup>] The references,
+        #         in the order of the paths, which are the existing ones for
+        #         the paths already referenced by the subgroups.
+        #
+        def new_references(paths)
+          FileReferencesFactory.new_references(self, paths)
+        end
+
         # Creates a file reference to a static library and adds it to the
         # group.
         #
@@ -429,27 +450,31 @@ module Xcodeproj
         # @return [void]
         #
         def sort(options = nil)
-          children.sort! do |x, y|
-            if options && groups_position = options[:groups_position]
-              raise ArgumentError unless [:above, :below].include?(groups_position)
-              if x.isa == 'PBXGroup' && !(y.isa == 'PBXGroup')
-                next groups_position == :above ? -1 : 1
-              elsif !(x.isa == 'PBXGroup') && y.isa == 'PBXGroup'
-                next groups_position == :above ? 1 : -1
-              end
-            end
-
-            result = File.basename(x.display_name.downcase, '.*') <=> File.basename(y.display_name.downcase, '.*')
-            if result.zero?
-              result = File.extname(x.display_name.downcase) <=> File.extname(y.display_name.downcase)
-              if result.zero? && !(x.path.nil? || y.path.nil?)
-                result = x.path.downcase <=> y.path.downcase
-              end
-            end
-            result
+          groups_position = options[:groups_position] if options
+          if groups_position && children.count > 1 && ![:above, :below].include?(groups_position)
+            raise ArgumentError
+          end
+          group_rank = groups_position == :above ? 0 : 1
+          children.sort_by_keys!(CHILDREN_COMPARATOR) do |child|
+            rank = groups_position ? (child.isa == 'PBXGroup' ? group_rank : 1 - group_rank) : 0
+            name = child.display_name.downcase
+            [rank, File.basename(name, '.*'), File.extname(name), child.path && child.path.downcase]
           end
         end
 
+        # @return [Proc] The comparison of the sort keys of two children. The
+        #         paths only order the children with the same name if both
+        #         have one.
+        #
+        CHILDREN_COMPARATOR = lambda do |x, y|
+          result = x[0] <=> y[0]
+          result = x[1] <=> y[1] if result.zero?
+          result = x[2] <=> y[2] if result.zero?
+          result = x[3] <=> y[3] if result.zero? && x[3] && y[3]
+          result
+        end
+        private_constant :CHILDREN_COMPARATOR
+
         # @return [Array<PBXBuildFile>] the build files associated with the
         #         current reference proxy.
         #
@@ -36,6 +36,62 @@ module Xcodeproj
             ref
           end
 
+          # Creates the references of the given paths in a single pass, adding
+          # each of them to the subgroup of the given group which matches its
+          # directory.
+          #
+          # The subgroups are looked up by name, as with
+          # {PBXGroup#find_subpath}, and created with the name of the
+          # directory as their path if needed, once per directory. The
+          # references which already exist in the subgroups are returned
+          # instead of being duplicated.
+          #
+          # @param  [PBXGroup] group
+          #         The group to which to add the references.
+          #
+          # @param  [Array<#to_s>] paths
+          #         The paths of the references, either absolute or relative
+          #         to the real path of the group.
+          #
+          # @return [Array<PBXFileReference, XCVersionGroup>] The references,
+          #         in the order of the paths.
+          #
+          def new_references(group, paths)
+            root = File.expand_path(group.real_path.to_s)
+            groups = { root => [group, root] }
+            existing = {}.compare_by_identity
+            added = {}.compare_by_identity
+            references = paths.map do |path|
+              path = File.expand_path(path.to_s, root)
+              directory = File.dirname(path)
+              parent, parent_path = groups.fetch(directory) { group_for_directory(directory, groups) }
+              parent, parent_path = group, root unless parent
+              relative_path = if parent_path == directory
+                                File.basename(path)
+                              else
+                                Pathname(path).relative_path_from(Pathname(parent_path)).to_s
+                              end
+              by_path = (existing[parent] ||= references_by_path(parent))
+              next by_path[relative_path] if by_path.key?(relative_path)
+              extension = File.extname(path).downcase
+              if parent_path != directory || extension == '.xcdatamodeld' || extension == '.xcodeproj'
+                pending = added.delete(parent)
+                parent.children.concat(pending) if pending
+                ref = new_reference(parent, path, :group)
+                next by_path[ref.path] = ref
+              end
+              ref = group.project.new(PBXFileReference)
+              ref.source_tree = '<group>'
+              ref.path = relative_path
+              ref.last_known_file_type = Constants::FILE_TYPES_BY_EXTENSION[File.extname(relative_path)[1..-1]]
+              configure_defaults_for_file_reference(ref)
+              (added[parent] ||= []) << ref
+              by_path[relative_path] = ref
+            end
+            added.each { |parent, refs| parent.children.concat(refs) }
+            references
+          end
+
           # Creates a file reference to a static library and adds it to the
           # given group.
           #
@@ -107,6 +163,43 @@ module Xcodeproj
             ref
           end
 
+          # Returns the subgroup matching the given directory, creating the
+          # missing groups of its ancestors, and caches it with its real path.
+          #
+          # @param  [String] directory
+          #         The absolute path of the directory.
+          #
+          # @param  [Hash{String => Array}] groups
+          #         The subgroups and their real paths, keyed by the directory
+          #         they match, which include the root group.
+          #
+          # @return [Array] The subgroup and its real path.
+          # @return [Nil] If the directory is not inside the root group.
+          #
+          def group_for_directory(directory, groups)
+            parent_directory = File.dirname(directory)
+            return groups[directory] = nil if parent_directory == directory
+            parent, = groups.fetch(parent_directory) { group_for_directory(parent_directory, groups) }
+            return groups[directory] = nil unless parent
+
+            name = File.basename(directory)
+            child = parent.groups.find { |g| g.display_name == name } || parent.new_group(name, name)
+            groups[directory] = [child, File.expand_path(child.real_path.to_s)]
+          end
+
+          # @param  [PBXGroup] group
+          #         The group whose references should be returned.
+          #
+          # @return [Hash{String => PBXFileReference, XCVersionGroup}] The
+          #         references of the group relative to it, keyed by path.
+          #
+          def references_by_path(group)
+            group.children.each_with_object({}) do |child, references|
+              next unless child.is_a?(PBXFileReference) || child.is_a?(XCVersionGroup)
+              references[child.path] = child if child.source_tree == '<group>' && child.path
+            end
+          end
+
           # Creates a new version group reference to an xcdatamodeled adding
           # the xcdatamodel files included in the wrapper as children file
           # references.
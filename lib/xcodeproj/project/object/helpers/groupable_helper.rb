@@ -9,22 +9,27 @@ module Xcodeproj
           #
           # @return [PBXGroup, PBXProject] The parent of the object.
           #
+          # @note   The parent is cached by the index of the project until the
+          #         referrers of the object change.
+          #
           def parent(object)
-            referrers = object.referrers.uniq
-            if referrers.count > 1
-              referrers = referrers.grep(PBXGroup)
-            end
+            object.project.object_index.parent(object) do
+              referrers = object.referrers.uniq
+              if referrers.count > 1
+                referrers = referrers.grep(PBXGroup)
+              end
 
-            if referrers.count == 0
-              raise '[Xcodeproj] Consistency issue: no parent ' \
-                "for object `#{object.display_name}`: "\
-                "`#{object.referrers.join('`, `')}`"
-            elsif referrers.count > 1
-              raise '[Xcodeproj] Consistency issue: unexpected multiple parents ' \
-                "for object `#{object.display_name}`: "\
-                "#{object.referrers}"
+              if referrers.count == 0
+                raise '[Xcodeproj] Consistency issue: no parent ' \
+                  "for object `#{object.display_name}`: "\
+                  "`#{object.referrers.join('`, `')}`"
+              elsif referrers.count > 1
+                raise '[Xcodeproj] Consistency issue: unexpected multiple parents ' \
+                  "for object `#{object.display_name}`: "\
+                  "#{object.referrers}"
+              end
+              referrers.first
             end
-            referrers.first
           end
 
           # @param  [PBXGroup, PBXFileReference] object
@@ -46,11 +51,15 @@ module Xcodeproj
           #
           # @return [String] A representation of the group hierarchy.
           #
+          # @note   The returned string is frozen as it is cached.
+          #
           def hierarchy_path(object)
-            unless main_group?(object)
-              parent = parent(object)
-              parent = parent.hierarchy_path if parent.respond_to?(:hierarchy_path)
-              "#{parent}/#{object.display_name}"
+            object.project.object_index.path(:hierarchy_path, object) do
+              unless main_group?(object)
+                parent = parent(object)
+                parent = parent.hierarchy_path if parent.respond_to?(:hierarchy_path)
+                "#{parent}/#{object.display_name}".freeze
+              end
             end
           end
 
@@ -98,12 +107,14 @@ module Xcodeproj
           #         source tree.
           #
           def real_path(object)
-            source_tree = source_tree_real_path(object)
-            path = object.path || ''.freeze
-            if source_tree
-              source_tree + path
-            else
-              Pathname(path)
+            object.project.object_index.path(:real_path, object) do
+              source_tree = source_tree_real_path(object)
+              path = object.path || ''.freeze
+              if source_tree
+                source_tree + path
+              else
+                Pathname(path)
+              end
             end
           end
 
@@ -114,26 +125,28 @@ module Xcodeproj
           #         source tree.
           #
           def full_path(object)
-            folder =  case object.source_tree
-                      when '<group>'
-                        object_parent = parent(object)
-                        if object_parent.isa == 'PBXProject'.freeze
+            object.project.object_index.path(:full_path, object) do
+              folder =  case object.source_tree
+                        when '<group>'
+                          object_parent = parent(object)
+                          if object_parent.isa == 'PBXProject'.freeze
+                            nil
+                          else
+                            full_path(object_parent)
+                          end
+                        when 'SOURCE_ROOT'
                           nil
+                        when '<absolute>'
+                          Pathname.new('/'.freeze)
                         else
-                          full_path(object_parent)
+                          Pathname.new("${#{object.source_tree}}")
                         end
-                      when 'SOURCE_ROOT'
-                        nil
-                      when '<absolute>'
-                        Pathname.new('/'.freeze)
-                      else
-                        Pathname.new("${#{object.source_tree}}")
-                      end
-            folder ||= Pathname.new('')
-            if object.path
-              folder + object.path
-            else
-              folder
+              folder ||= Pathname.new('')
+              if object.path
+                folder + object.path
+              else
+                folder
+              end
             end
           end
 
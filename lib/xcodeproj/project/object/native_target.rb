@@ -52,22 +52,67 @@ module Xcodeproj
         #         the default values for the platform.
         #
         def resolved_build_setting(key, resolve_against_xcconfig = false)
-          target_settings = build_configuration_list.get_setting(key, resolve_against_xcconfig, self)
-          project_settings = project.build_configuration_list.get_setting(key, resolve_against_xcconfig)
-          target_settings.merge(project_settings) do |_key, target_val, proj_val|
-            target_includes_inherited = Constants::INHERITED_KEYWORDS.any? { |keyword| target_val.include?(keyword) } if target_val
-            if target_includes_inherited && proj_val
-              if target_val.is_a? String
-                target_val.gsub(Regexp.union(Constants::INHERITED_KEYWORDS), proj_val)
-              else
-                target_val.flat_map { |value| Constants::INHERITED_KEYWORDS.include?(value) ? proj_val : value }
-              end
-            else
-              target_val || proj_val
+          Instrumentation.instrument('target.resolved_build_setting', self) do
+            target_settings = build_configuration_list.get_setting(key, resolve_against_xcconfig, self)
+            project_settings = project.build_configuration_list.get_setting(key, resolve_against_xcconfig)
+            target_settings.merge(project_settings) do |_key, target_val, proj_val|
+              inherit_build_setting(target_val, proj_val)
             end
           end
         end
 
+        # Gets the values of all the build settings of the given build
+        # configuration, considering any configuration file present, as
+        # {#resolved_build_setting} would do for each of them. This is similar
+        # to the output of `xcodebuild -showBuildSettings`, without the default
+        # values of the platform.
+        #
+        # The build settings referenced by multiple values are resolved only
+        # once and the result is cached until the build settings or the
+        # configuration files of the target or of the project, or the
+        # environment variables read by the resolution, change.
+        #
+        # @param [String] configuration_name
+        #        the name of the build configuration.
+        #
+        # @return [Hash{String => String}] The values of the build settings
+        #         defined by the build configuration of the target or by the
+        #         one of the project, which are not nil.
+        #
+        def resolved_build_settings(configuration_name)
+          Instrumentation.instrument('target.resolved_build_settings', self) do
+            resolve_build_settings(configuration_name)
+          end
+        end
+
+        # @return [Hash{String => String}] The values of the build settings of
+        #         the given build configuration, see
+        #         {#resolved_build_settings}.
+        #
+        def resolve_build_settings(configuration_name)
+          target_configuration = build_configuration_list[configuration_name]
+          project_configuration = project.build_configuration_list[configuration_name]
+          configurations = [target_configuration, project_configuration].compact
+          stamp = configurations.map(&:build_settings_resolution_stamp)
+
+          @resolved_build_settings ||= {}
+          cached_stamp, env, cached = @resolved_build_settings[configuration_name]
+          if cached_stamp == stamp && env.all? { |key, value| ENV[key] == value }
+            return cached.dup
+          end
+
+          keys = configurations.map(&:build_setting_keys).inject(:|) || []
+          env = {}
+          target_settings = target_configuration ? target_configuration.resolve_build_settings(keys, self, env) : {}
+          project_settings = project_configuration ? project_configuration.resolve_build_settings(keys, nil, env) : {}
+          settings = target_settings.merge(project_settings) do |_key, target_val, proj_val|
+            inherit_build_setting(target_val, proj_val)
+          end
+          @resolved_build_settings[configuration_name] = [stamp, env, settings]
+          settings.dup
+        end
+        private :resolve_build_settings
+
         # Gets the value for the given build setting, properly inherited if
         # need, if shared across the build configurations.
         #
@@ -88,13 +133,32 @@ module Xcodeproj
         # @return [String] The value of the build setting.
         #
         def common_resolved_build_setting(key, resolve_against_xcconfig: false)
-          values = resolved_build_setting(key, resolve_against_xcconfig).values.compact.uniq
+          settings = resolved_build_setting(key, resolve_against_xcconfig)
+          values = settings.values.compact.uniq
           if values.count <= 1
             values.first
           else
-            raise "[Xcodeproj] Consistency issue: build setting `#{key}` has multiple values: `#{resolved_build_setting(key)}`"
+            raise "[Xcodeproj] Consistency issue: build setting `#{key}` has multiple values: `#{settings}`"
+          end
+        end
+
+        # @return [String, Array<String>] The value of a build setting of a
+        #         target with the `$(inherited)` keywords replaced by the
+        #         value of the project.
+        #
+        def inherit_build_setting(target_val, proj_val)
+          target_includes_inherited = Constants::INHERITED_KEYWORDS.any? { |keyword| target_val.include?(keyword) } if target_val
+          if target_includes_inherited && proj_val
+            if target_val.is_a? String
+              target_val.gsub(Constants::INHERITED_KEYWORDS_REGEXP, proj_val)
+            else
+              target_val.flat_map { |value| Constants::INHERITED_KEYWORDS.include?(value) ? proj_val : value }
+            end
+          else
+            target_val || proj_val
           end
         end
+        private :inherit_build_setting
 
         # @return [String] the SDK that the target should use.
         #
@@ -406,6 +470,23 @@ module Xcodeproj
         end
         alias_method :add_system_libraries_tbd, :add_system_library_tbd
 
+        # Appends the given compiler flags to the settings of a build file.
+        #
+        # @param  [PBXBuildFile] build_file
+        #         the build file of a source file.
+        #
+        # @param  [String] compiler_flags
+        #         the compiler flags for the source file.
+        #
+        # @return [void]
+        #
+        def add_compiler_flags(build_file, compiler_flags)
+          return if compiler_flags.nil? || compiler_flags.empty?
+          (build_file.settings ||= {}).merge!('COMPILER_FLAGS' => compiler_flags) do |_, old, new|
+            [old, new].compact.join(' ')
+          end
+        end
+
         public
 
         # @!group AbstractObject Hooks
@@ -536,11 +617,7 @@ module Xcodeproj
               phase.files << build_file
             end
 
-            if compiler_flags && !compiler_flags.empty? && !is_header_phase
-              (build_file.settings ||= {}).merge!('COMPILER_FLAGS' => compiler_flags) do |_, old, new|
-                [old, new].compact.join(' ')
-              end
-            end
+            add_compiler_flags(build_file, compiler_flags) unless is_header_phase
 
             yield build_file if block_given?
 
@@ -564,6 +641,69 @@ module Xcodeproj
           end
         end
 
+        # Adds the files at the given paths to the target, creating in a single
+        # pass their references, the groups which contain them and their build
+        # files.
+        #
+        # The headers are added to the headers build phase, the files with one
+        # of the {Constants::SOURCE_FILES_EXTENSIONS} to the source build phase,
+        # the ones with one of the {Constants::FRAMEWORK_FILES_EXTENSIONS} to
+        # the frameworks build phase and the ones with one of the
+        # {Constants::RESOURCE_FILES_EXTENSIONS} to the resources build phase,
+        # unless they are already part of the phase. The other files, like the
+        # property lists, the configuration files or the subprojects, are only
+        # added to the group.
+        #
+        # @note   The files are added in a {Project#transaction}.
+        #
+        # @param  [Array<#to_s>] paths
+        #         the paths of the files, either absolute or relative to the
+        #         real path of the group.
+        #
+        # @param  [PBXGroup] group
+        #         the group to which the references should be added, in the
+        #         subgroups matching their directories (see
+        #         {PBXGroup#new_references}). The main group by default.
+        #
+        # @param  [String] compiler_flags
+        #         the compiler flags for the source files.
+        #
+        # @return [Array<PBXFileReference, XCVersionGroup>] the references of
+        #         the files, in the order of the paths.
+        #
+        def add_files(paths, group: nil, compiler_flags: nil)
+          project.transaction do
+            file_references = (group || project.main_group).new_references(paths)
+            phases_by_extension = Hash.new do |phases, extension|
+              phases[extension] = if Constants::HEADER_FILES_EXTENSIONS.include?(extension)
+                                    headers_build_phase
+                                  elsif Constants::SOURCE_FILES_EXTENSIONS.include?(extension)
+                                    source_build_phase
+                                  elsif Constants::FRAMEWORK_FILES_EXTENSIONS.include?(extension)
+                                    frameworks_build_phase
+                                  elsif Constants::RESOURCE_FILES_EXTENSIONS.include?(extension)
+                                    resources_build_phase
+                                  end
+            end
+            build_files_by_phase = {}.compare_by_identity
+            new_build_files = {}.compare_by_identity
+            file_references.uniq(&:object_id).each do |file|
+              next unless phase = phases_by_extension[File.extname(file.path).downcase]
+              build_files = build_files_by_phase[phase] ||= phase.files.each_with_object({}.compare_by_identity) do |build_file, hash|
+                hash[build_file.file_ref] ||= build_file
+              end
+              unless build_file = build_files[file]
+                build_file = build_files[file] = project.new(PBXBuildFile)
+                build_file.file_ref = file
+                (new_build_files[phase] ||= []) << build_file
+              end
+              add_compiler_flags(build_file, compiler_flags) if phase.is_a?(PBXSourcesBuildPhase)
+            end
+            new_build_files.each { |phase, build_files| phase.files.concat(build_files) }
+            file_references
+          end
+        end
+
         # Adds on demand resources to the resources build phase of the target.
         #
         # @param  {String => [Array<PBXFileReference>]} on_demand_resource_tag_files
@@ -681,9 +821,7 @@ module Xcodeproj
           attributes_to_sort = to_many_attributes.reject { |attr| attr.name == :build_phases }
           attributes_to_sort.each do |attrb|
             list = attrb.get_value(self)
-            list.sort! do |x, y|
-              x.display_name <=> y.display_name
-            end
+            list.sort_by_keys!(&:display_name)
           end
         end
 
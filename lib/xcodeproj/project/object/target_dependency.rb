@@ -84,6 +84,16 @@ module Xcodeproj
           hash
         end
 
+        # @note This override is necessary because Xcode allows for circular
+        #       target dependencies, so the target contributes only its UUID.
+        #
+        # @see AbstractObject#digest
+        #
+        def to_one_digest(attrb, obj)
+          attrb.name == :target ? obj.uuid : super
+        end
+        private :to_one_digest
+
         # @note This is a no-op, because the targets could theoretically depend
         #   on each other, leading to a stack level too deep error.
         #
@@ -305,15 +305,29 @@ module Xcodeproj
             attrb.classes = [klass]
             attrb.default_value = default_value
             add_attribute(attrb)
+            indexed = ObjectIndex::INDEXED_ATTRIBUTES.include?(attrb.name)
 
             define_method(attrb.name) do
               @simple_attributes_hash ||= {}
-              @simple_attributes_hash[attrb.plist_name]
+              value = @simple_attributes_hash[attrb.plist_name]
+              if value.is_a?(Hash) || value.is_a?(Array)
+                # The value might be modified in place.
+                project.preserve_for_forks(self)
+                project.digest_value_read(self) if @digest
+                ascii_plist_value_read if @ascii_plist_cache
+                transaction = project.current_transaction
+                transaction.journal(self) if transaction
+              end
+              value
             end
 
             define_method("#{attrb.name}=") do |value|
               @simple_attributes_hash ||= {}
-              attrb.validate_value(value)
+              if transaction = project.current_transaction
+                transaction.validate_later(attrb, value)
+              else
+                attrb.validate_value(value)
+              end
 
               existing = @simple_attributes_hash[attrb.plist_name]
               if existing.is_a?(Hash) && value.is_a?(Hash)
@@ -323,6 +337,8 @@ module Xcodeproj
               end
               mark_project_as_dirty!
               @simple_attributes_hash[attrb.plist_name] = value
+              project.object_index.attribute_changed(self, attrb.name) if indexed
+              value
             end
           end
 
@@ -350,13 +366,20 @@ module Xcodeproj
             attrb.classes = isas
             add_attribute(attrb)
 
-            attr_reader(attrb.name)
+            variable_name = :"@#{attrb.name}"
+            define_method(attrb.name) do
+              project.materialize_object(self) if @relationships_pending
+              instance_variable_get(variable_name)
+            end
             # 1.9.2 fix, see https://github.com/CocoaPods/Xcodeproj/issues/40.
             public(attrb.name)
 
-            variable_name = :"@#{attrb.name}"
             define_method("#{attrb.name}=") do |value|
-              attrb.validate_value(value)
+              if transaction = project.current_transaction
+                transaction.validate_later(attrb, value)
+              else
+                attrb.validate_value(value)
+              end
 
               previous_value = send(attrb.name)
               return value if previous_value == value
@@ -396,6 +419,7 @@ module Xcodeproj
             variable_name = :"@#{attrb.name}"
             define_method(attrb.name) do
               # Here we are in the context of the instance
+              project.materialize_object(self) if @relationships_pending
               list = instance_variable_get(variable_name)
               unless list
                 list = ObjectList.new(attrb, self)
@@ -433,6 +457,7 @@ module Xcodeproj
             variable_name = :"@#{attrb.name}"
             define_method(attrb.name) do
               # Here we are in the context of the instance
+              project.materialize_object(self) if @relationships_pending
               list = instance_variable_get(variable_name)
               unless list
                 list = ObjectList.new(attrb, self)
@@ -117,14 +117,21 @@ module Xcodeproj
         each do |key, obj|
           if obj
             plist_key = Object::CaseConverter.convert_to_plist(key, nil)
-            result[plist_key] = Nanaimo::String.new(obj.uuid, obj.ascii_plist_annotation)
+            result[plist_key] = obj.uuid
           end
         end
         result
       end
 
       def to_ascii_plist
-        to_hash
+        result = {}
+        each do |key, obj|
+          if obj
+            plist_key = Object::CaseConverter.convert_to_plist(key, nil)
+            result[plist_key] = Nanaimo::String.new(obj.uuid, obj.ascii_plist_annotation)
+          end
+        end
+        result
       end
 
       # @return [Hash<String => String>] Returns a cascade representation of
@@ -147,6 +154,15 @@ module Xcodeproj
         each { |key, obj| self[key] = nil if obj == object }
       end
 
+      # Removes all the references to the given objects.
+      #
+      # @param  [Hash{AbstractObject => Boolean}] objects
+      #         The objects to remove, as a hash comparing by identity.
+      #
+      def remove_references(objects)
+        each { |key, obj| self[key] = nil if obj && objects.key?(obj) }
+      end
+
       # Informs the objects contained in the dictionary that another object is
       # referencing them.
       #
@@ -0,0 +1,579 @@
+module Xcodeproj
+  class Project
+    # This class maintains the secondary indexes of the objects of a project,
+    # which allow to answer the most common queries without scanning all the
+    # objects.
+    #
+    # The indexes are updated incrementally by {AbstractObject} as the objects
+    # are added to or removed from the project (i.e. when they gain their
+    # first referrer or lose their last one) and as the attributes which
+    # affect them change.
+    #
+    # It also caches the parents and the paths of the groups and of the file
+    # references resolved by {Object::GroupableHelper}. As the paths of an
+    # object depend on the ones of its parent, the cached paths of a whole
+    # subtree are discarded when an object is moved or when its path, its
+    # source tree or its name change.
+    #
+    # The updates of the indexes can be deferred, see {#defer_updates}, in
+    # which case the notifications are coalesced by object and applied on the
+    # next query. The cached parents and paths are always discarded
+    # immediately, as they are queried for each new file reference.
+    #
+    # @note Clients of {Xcodeproj} are not expected to use this class
+    #       directly, it powers the convenience accessors of {Project} and
+    #       {Object::PBXGroup}.
+    #
+    class ObjectIndex
+      # @return [Array<Symbol>] The names of the simple attributes whose
+      #         changes need to be reported to the index.
+      #
+      INDEXED_ATTRIBUTES = [
+        :name,
+        :path,
+        :source_tree,
+        :project_dir_path,
+        :project_root,
+        :container_portal,
+        :remote_global_id_string,
+      ].freeze
+
+      def initialize
+        @objects_by_class = {}
+        @file_references_by_name = {}
+        @name_by_file_reference = {}.compare_by_identity
+        @file_references_by_real_path = nil
+        @real_path_by_file_reference = nil
+        @stale_file_references = nil
+        @proxies_by_container_portal = {}
+        @proxies_by_remote_global_id = {}
+        @uuids_by_proxy = {}.compare_by_identity
+        @parents = {}.compare_by_identity
+        @children_by_parent = {}.compare_by_identity
+        @paths = Hash.new { |paths, kind| paths[kind] = {}.compare_by_identity }
+        @pending_updates = nil
+      end
+
+      # @!group Queries
+      #-----------------------------------------------------------------------#
+
+      # @param  [Class] klass
+      #         The class of the objects.
+      #
+      # @return [Array<AbstractObject>] The objects of the project whose
+      #         class is exactly the given one.
+      #
+      def objects_of_class(klass)
+        apply_pending_updates
+        objects = @objects_by_class[klass]
+        objects ? objects.keys : []
+      end
+
+      # @param  [String] name
+      #         The last path component of the file references.
+      #
+      # @return [Array<PBXFileReference>] The file references whose path has
+      #         the given last component.
+      #
+      def file_references_with_name(name)
+        apply_pending_updates
+        references = @file_references_by_name[name]
+        references ? references.keys : []
+      end
+
+      # @param  [Pathname] real_path
+      #         The absolute path of the file references.
+      #
+      # @return [Array<PBXFileReference>] The file references whose real path
+      #         is the given one.
+      #
+      def file_references_with_real_path(real_path)
+        apply_pending_updates
+        build_real_paths unless @file_references_by_real_path
+        refresh_stale_real_paths
+        references = @file_references_by_real_path[real_path]
+        references ? references.keys : []
+      end
+
+      # @param  [String] uuid
+      #         The UUID of the container portal, i.e. the root object of the
+      #         project or the file reference of a sub-project.
+      #
+      # @return [Array<PBXContainerItemProxy>] The container item proxies
+      #         whose container portal is the given UUID.
+      #
+      def container_item_proxies_with_portal(uuid)
+        apply_pending_updates
+        proxies = @proxies_by_container_portal[uuid]
+        proxies ? proxies.keys : []
+      end
+
+      # @param  [String] uuid
+      #         The UUID of the proxied object.
+      #
+      # @return [Array<PBXContainerItemProxy>] The container item proxies
+      #         whose remote global ID is the given UUID.
+      #
+      def container_item_proxies_with_remote_global_id(uuid)
+        apply_pending_updates
+        proxies = @proxies_by_remote_global_id[uuid]
+        proxies ? proxies.keys : []
+      end
+
+      # @!group Paths
+      #-----------------------------------------------------------------------#
+
+      # @param  [AbstractObject] object
+      #         The object whose parent is requested.
+      #
+      # @yieldreturn [PBXGroup, PBXProject, AbstractObject] The parent of the
+      #         object, computed if it is not cached.
+      #
+      # @return [PBXGroup, PBXProject, AbstractObject] The parent of the
+      #         object.
+      #
+      def parent(object)
+        @parents.fetch(object) do
+          parent = yield
+          @parents[object] = parent
+          (@children_by_parent[parent] ||= {}.compare_by_identity)[object] = true
+          parent
+        end
+      end
+
+      # @param  [Symbol] kind
+      #         The kind of path, i.e. `:real_path`, `:full_path` or
+      #         `:hierarchy_path`.
+      #
+      # @param  [AbstractObject] object
+      #         The object whose path is requested.
+      #
+      # @yieldreturn [Pathname, String, Nil] The path of the object, computed
+      #         if it is not cached.
+      #
+      # @return [Pathname, String, Nil] The path of the object.
+      #
+      def path(kind, object)
+        paths = @paths[kind]
+        paths.fetch(object) { paths[object] = yield }
+      end
+
+      # @!group Notifications
+      #-----------------------------------------------------------------------#
+
+      # Informs the index that an object is part of the project or that it
+      # gained a referrer. Calling this method multiple times for the same
+      # object is safe.
+      #
+      # @param  [AbstractObject] object
+      #         The added object.
+      #
+      # @return [void]
+      #
+      def object_added(object)
+        return defer_update(object, :added) if @pending_updates
+        objects = (@objects_by_class[object.class] ||= {}.compare_by_identity)
+        unless objects.key?(object)
+          objects[object] = true
+          case object
+          when Object::PBXFileReference then update_name(object)
+          when Object::PBXContainerItemProxy then update_proxy(object)
+          end
+        end
+        referrers_changed(object)
+      end
+
+      # Informs the index that an object has been removed from the project.
+      #
+      # @param  [AbstractObject] object
+      #         The removed object.
+      #
+      # @return [void]
+      #
+      def object_removed(object)
+        return defer_update(object, :removed) if @pending_updates
+        invalidate_parent(object)
+        objects = @objects_by_class[object.class]
+        return unless objects && objects.delete(object)
+        case object
+        when Object::PBXFileReference
+          remove_name(object)
+          @stale_file_references[object] = true if @stale_file_references
+        when Object::PBXGroup
+          invalidate_real_paths(object) if @stale_file_references
+        when Object::PBXContainerItemProxy
+          remove_proxy(object)
+        end
+      end
+
+      # Informs the index that the referrers of an object changed, which
+      # might imply that the object has been moved to another group.
+      #
+      # @param  [AbstractObject] object
+      #         The object whose referrers changed.
+      #
+      # @return [void]
+      #
+      def referrers_changed(object)
+        return defer_update(object, :referrers) if @pending_updates
+        invalidate_parent(object)
+        return unless @file_references_by_real_path
+        if object.is_a?(Object::PBXFileReference)
+          @stale_file_references[object] = true
+        elsif object.is_a?(Object::PBXGroup)
+          invalidate_real_paths(object)
+        end
+      end
+
+      # Informs the index that one of the {INDEXED_ATTRIBUTES} of an object
+      # changed.
+      #
+      # @param  [AbstractObject] object
+      #         The object whose attribute changed.
+      #
+      # @param  [Symbol] attribute_name
+      #         The name of the attribute.
+      #
+      # @return [void]
+      #
+      def attribute_changed(object, attribute_name)
+        return defer_update(object, attribute_name) if @pending_updates
+        if attribute_name == :project_dir_path
+          @paths.clear
+        else
+          invalidate_paths(object)
+        end
+        return if attribute_name == :name
+        objects = @objects_by_class[object.class]
+        return unless objects && objects.key?(object)
+        case object
+        when Object::PBXFileReference
+          update_name(object) if attribute_name == :path
+          @stale_file_references[object] = true if @stale_file_references
+        when Object::PBXGroup
+          invalidate_real_paths(object) if @stale_file_references
+        when Object::PBXProject
+          discard_real_paths
+        when Object::PBXContainerItemProxy
+          update_proxy(object)
+        end
+      end
+
+      # @!group Deferred updates
+      #-----------------------------------------------------------------------#
+
+      # Defers the updates of the indexes until the next query or until
+      # {#resume_updates}. The notifications received in the meantime are
+      # coalesced, so each object is indexed once whatever the number of
+      # changes.
+      #
+      # @return [void]
+      #
+      def defer_updates
+        @pending_updates ||= {}.compare_by_identity
+      end
+
+      # Applies the deferred updates and stops deferring them.
+      #
+      # @return [void]
+      #
+      def resume_updates
+        apply_pending_updates
+        @pending_updates = nil
+      end
+
+      # Applies the updates deferred since the last query, if any. The
+      # membership of an object is updated according to the last
+      # notification about it. The changes of its attributes are applied
+      # only if it was already indexed, as indexing it takes their current
+      # values into account.
+      #
+      # @return [void]
+      #
+      def apply_pending_updates
+        pending = @pending_updates
+        return if pending.nil? || pending.empty?
+        @pending_updates = nil
+        begin
+          pending.each do |object, (membership, referrers_changed, attribute_names)|
+            next object_removed(object) if membership == :removed
+            objects = @objects_by_class[object.class]
+            indexed = objects && objects.key?(object)
+            if indexed
+              referrers_changed(object) if membership || referrers_changed
+              attribute_names.each { |name| attribute_changed(object, name) } if attribute_names
+            elsif membership == :added
+              object_added(object)
+            end
+          end
+        ensure
+          pending.clear
+          @pending_updates = pending
+        end
+      end
+
+      # @!group Consistency
+      #-----------------------------------------------------------------------#
+
+      # Checks that the index is consistent with the given objects, which are
+      # expected to be all the objects of the project.
+      #
+      # @param  [Array<AbstractObject>] objects
+      #         The objects of the project.
+      #
+      # @raise  If any of the indexes is not consistent.
+      #
+      # @return [void]
+      #
+      def verify!(objects)
+        apply_pending_updates
+        expected = ObjectIndex.new
+        objects.each { |object| expected.object_added(object) }
+
+        actual_classes = @objects_by_class.reject { |_, objs| objs.empty? }
+        unless normalize(actual_classes) == normalize(expected.objects_by_class)
+          raise '[Xcodeproj] BUG: The index of the objects by class is inconsistent.'
+        end
+
+        actual_names = @file_references_by_name.reject { |_, refs| refs.empty? }
+        unless normalize(actual_names) == normalize(expected.file_references_by_name)
+          raise '[Xcodeproj] BUG: The index of the file references by name is inconsistent.'
+        end
+
+        actual_proxies = [@proxies_by_container_portal, @proxies_by_remote_global_id].map do |index|
+          normalize(index.reject { |_, proxies| proxies.empty? })
+        end
+        expected_proxies = [expected.proxies_by_container_portal, expected.proxies_by_remote_global_id].map do |index|
+          normalize(index)
+        end
+        unless actual_proxies == expected_proxies
+          raise '[Xcodeproj] BUG: The index of the container item proxies is inconsistent.'
+        end
+
+        if @file_references_by_real_path
+          refresh_stale_real_paths
+          expected.send(:build_real_paths)
+          actual_paths = @file_references_by_real_path.reject { |_, refs| refs.empty? }
+          unless normalize(actual_paths) == normalize(expected.file_references_by_real_path)
+            raise '[Xcodeproj] BUG: The index of the file references by real path is inconsistent.'
+          end
+        end
+      end
+
+      protected
+
+      # @return [Hash{Class => Hash{AbstractObject => true}}] The objects of
+      #         the project grouped by class.
+      #
+      attr_reader :objects_by_class
+
+      # @return [Hash{String => Hash{PBXFileReference => true}}] The file
+      #         references grouped by the last component of their path.
+      #
+      attr_reader :file_references_by_name
+
+      # @return [Hash{Pathname => Hash{PBXFileReference => true}}] The file
+      #         references grouped by real path.
+      #
+      attr_reader :file_references_by_real_path
+
+      # @return [Hash{String => Hash{PBXContainerItemProxy => true}}] The
+      #         container item proxies grouped by container portal.
+      #
+      attr_reader :proxies_by_container_portal
+
+      # @return [Hash{String => Hash{PBXContainerItemProxy => true}}] The
+      #         container item proxies grouped by remote global ID.
+      #
+      attr_reader :proxies_by_remote_global_id
+
+      private
+
+      # @!group Private helpers
+      #-----------------------------------------------------------------------#
+
+      # Records a notification about the given object while the updates are
+      # deferred.
+      #
+      # @param  [Symbol] change
+      #         `:added`, `:removed`, `:referrers` or the name of the changed
+      #         attribute.
+      #
+      # @return [void]
+      #
+      def defer_update(object, change)
+        update = (@pending_updates[object] ||= [nil, false, nil])
+        case change
+        when :added, :removed
+          invalidate_parent(object)
+          update[0] = change
+        when :referrers
+          invalidate_parent(object)
+          update[1] = true
+        else
+          change == :project_dir_path ? @paths.clear : invalidate_paths(object)
+          attribute_names = (update[2] ||= [])
+          attribute_names << change unless attribute_names.include?(change)
+        end
+      end
+
+      # Indexes a file reference by the last component of its current path.
+      #
+      # @return [void]
+      #
+      def update_name(file_reference)
+        remove_name(file_reference)
+        return unless file_reference.path
+        name = File.basename(file_reference.path)
+        @name_by_file_reference[file_reference] = name
+        (@file_references_by_name[name] ||= {}.compare_by_identity)[file_reference] = true
+      end
+
+      # Removes a file reference from the index by name.
+      #
+      # @return [void]
+      #
+      def remove_name(file_reference)
+        name = @name_by_file_reference.delete(file_reference)
+        @file_references_by_name[name].delete(file_reference) if name
+      end
+
+      # Indexes a container item proxy by its current container portal and
+      # remote global ID.
+      #
+      # @return [void]
+      #
+      def update_proxy(proxy)
+        remove_proxy(proxy)
+        portal = proxy.container_portal
+        remote_id = proxy.remote_global_id_string
+        @uuids_by_proxy[proxy] = [portal, remote_id]
+        (@proxies_by_container_portal[portal] ||= {}.compare_by_identity)[proxy] = true if portal
+        (@proxies_by_remote_global_id[remote_id] ||= {}.compare_by_identity)[proxy] = true if remote_id
+      end
+
+      # Removes a container item proxy from the indexes of the proxies.
+      #
+      # @return [void]
+      #
+      def remove_proxy(proxy)
+        portal, remote_id = @uuids_by_proxy.delete(proxy)
+        @proxies_by_container_portal[portal].delete(proxy) if portal
+        @proxies_by_remote_global_id[remote_id].delete(proxy) if remote_id
+      end
+
+      # Computes the real path of all the file references. The real paths
+      # are computed lazily because they depend on the whole group hierarchy.
+      #
+      # @return [void]
+      #
+      def build_real_paths
+        @file_references_by_real_path = {}
+        @real_path_by_file_reference = {}.compare_by_identity
+        @stale_file_references = {}.compare_by_identity
+        objects_of_class(Object::PBXFileReference).each do |file_reference|
+          add_real_path(file_reference)
+        end
+      end
+
+      # Recomputes the real paths of the file references which have been
+      # modified since the last query.
+      #
+      # @return [void]
+      #
+      def refresh_stale_real_paths
+        return if @stale_file_references.empty?
+        file_references = @objects_by_class[Object::PBXFileReference] || {}
+        @stale_file_references.each_key do |file_reference|
+          remove_real_path(file_reference)
+          add_real_path(file_reference) if file_references.key?(file_reference)
+        end
+        @stale_file_references.clear
+      end
+
+      # Indexes a file reference by its real path. File references whose
+      # real path can't be computed (e.g. because they are not part of any
+      # group) are not indexed.
+      #
+      # @return [void]
+      #
+      def add_real_path(file_reference)
+        real_path = begin
+                      file_reference.real_path
+                    rescue RuntimeError
+                      nil
+                    end
+        return unless real_path
+        @real_path_by_file_reference[file_reference] = real_path
+        (@file_references_by_real_path[real_path] ||= {}.compare_by_identity)[file_reference] = true
+      end
+
+      # Removes a file reference from the index by real path.
+      #
+      # @return [void]
+      #
+      def remove_real_path(file_reference)
+        real_path = @real_path_by_file_reference.delete(file_reference)
+        @file_references_by_real_path[real_path].delete(file_reference) if real_path
+      end
+
+      # Discards the cached parent of an object, which might have been moved,
+      # and the cached paths of its subtree.
+      #
+      # @return [void]
+      #
+      def invalidate_parent(object)
+        if @parents.key?(object)
+          parent = @parents.delete(object)
+          @children_by_parent[parent].delete(object)
+        end
+        invalidate_paths(object)
+      end
+
+      # Discards the cached paths of an object and of the objects whose
+      # cached parent is, directly or not, the object. Their cached parents
+      # are kept, as they did not change.
+      #
+      # @return [void]
+      #
+      def invalidate_paths(object)
+        return if @paths.empty?
+        @paths.each_value { |paths| paths.delete(object) }
+        children = @children_by_parent[object]
+        children.each_key { |child| invalidate_paths(child) } if children
+      end
+
+      # Marks the file references of the subtree of a group as stale, as
+      # their real paths depend on the one of the group.
+      #
+      # @return [void]
+      #
+      def invalidate_real_paths(group)
+        group.children.each do |child|
+          case child
+          when Object::PBXFileReference then @stale_file_references[child] = true
+          when Object::PBXGroup then invalidate_real_paths(child)
+          end
+        end
+      end
+
+      # Discards the index by real path, which will be rebuilt on the next
+      # query.
+      #
+      # @return [void]
+      #
+      def discard_real_paths
+        @file_references_by_real_path = nil
+        @real_path_by_file_reference = nil
+        @stale_file_references = nil
+      end
+
+      # @return [Hash] The given index with the sets converted to arrays of
+      #         UUIDs, suitable for comparison.
+      #
+      def normalize(index)
+        Hash[index.map { |key, objects| [key, objects.keys.map(&:uuid).sort] }]
+      end
+    end
+  end
+end
@@ -65,6 +65,61 @@ module Xcodeproj
         super
       end
 
+      # Appends the objects of the given arrays to the list and updates their
+      # references count.
+      #
+      # @note   The objects are validated once per class and the project is
+      #         marked as dirty only once, making this the preferred way to
+      #         add many objects to a list.
+      #
+      # @param  [Array<Array<AbstractObject, ObjectDictionary>>] others
+      #         The arrays of objects to add to the list.
+      #
+      # @return [ObjectList] The list.
+      #
+      def concat(*others)
+        objects = others.flatten(1)
+        perform_additions_operations(objects)
+        super(objects)
+      end
+
+      # Replaces the contents of the list with the given objects and updates
+      # the references count of both the removed and the added objects.
+      #
+      # @note   The new objects are validated before the list is modified, and
+      #         the objects which are part of both the current and the new
+      #         contents keep their references.
+      #
+      # @param  [Array<AbstractObject, ObjectDictionary>] objects
+      #         The new objects of the list.
+      #
+      # @return [ObjectList] The list.
+      #
+      def replace(objects)
+        kept = objects.each_with_object({}.compare_by_identity) { |obj, hash| hash[obj] = true }
+        removed = reject { |obj| kept.key?(obj) }
+        perform_additions_operations(objects)
+        perform_deletion_operations(removed)
+        super
+      end
+
+      # Inserts the given objects at the given index of the list and updates
+      # their references count.
+      #
+      # @param  [Integer] index
+      #         The index at which the objects should be inserted.
+      #
+      # @param  [Array<AbstractObject, ObjectDictionary>] objects
+      #         The objects to add to the list.
+      #
+      # @return [ObjectList] The list.
+      #
+      def insert_all(index, objects)
+        perform_additions_operations(objects)
+        self[index, 0] = objects
+        self
+      end
+
       # Appends an object to list the and updates its references count.
       #
       # @param  [AbstractObject, ObjectDictionary] object
@@ -114,6 +169,25 @@ module Xcodeproj
         super
       end
 
+      # Removes all the given objects from the list in a single pass and
+      # updates their references count.
+      #
+      # @param  [Hash{AbstractObject => Boolean}, Array<AbstractObject>] objects
+      #         The objects to remove. Objects are compared by identity.
+      #
+      # @return [Array<AbstractObject>] The objects which have been removed.
+      #
+      def delete_objects(objects)
+        unless objects.is_a?(Hash) && objects.compare_by_identity?
+          objects = Hash[objects.map { |object| [object, true] }].compare_by_identity
+        end
+        removed = select { |object| objects.key?(object) }
+        return removed if removed.empty?
+        perform_deletion_operations(removed.uniq)
+        reject! { |object| objects.key?(object) }
+        removed
+      end
+
       # Removes the object at the given index from the list and updates its
       # references count.
       #
@@ -178,16 +252,62 @@ module Xcodeproj
         end
       end
 
-      def sort!
-        return super if owner.project.dirty?
-        previous = to_a
-        super
-        owner.mark_project_as_dirty! unless previous == to_a
-        self
+      # Sorts the list in place and marks the project as dirty if the order
+      # of the objects changed.
+      #
+      # @return [ObjectList] The list.
+      #
+      def sort!(&block)
+        reorder(block ? sort(&block) : sort)
+      end
+
+      # Sorts the list in place according to a key computed once per object,
+      # instead of once per comparison.
+      #
+      # @note   The keys are compared with the same algorithm as {#sort!}, so
+      #         objects with equal keys end up in the same order as if the
+      #         comparison was performed on the objects themselves.
+      #
+      # @param  [Proc] comparator
+      #         The comparison of two keys, `<=>` if nil.
+      #
+      # @yieldparam [AbstractObject, ObjectDictionary] object
+      #         An object of the list.
+      #
+      # @yieldreturn [Object] The sort key of the object.
+      #
+      # @return [ObjectList] The list.
+      #
+      def sort_by_keys!(comparator = nil)
+        return self if count < 2
+        keys = map { |object| yield object }
+        order = (0...count).to_a
+        if comparator
+          order.sort! { |x, y| comparator.call(keys[x], keys[y]) }
+        else
+          order.sort! { |x, y| keys[x] <=> keys[y] }
+        end
+        reorder(order.map { |index| at(index) })
       end
 
       private
 
+      # Replaces the objects of the list with the same objects in the given
+      # order and marks the project as dirty if the order changed.
+      #
+      # @param  [Array<AbstractObject, ObjectDictionary>] sorted
+      #         The objects of the list in their new order.
+      #
+      # @return [ObjectList] The list.
+      #
+      def reorder(sorted)
+        changed = sorted.each_with_index.any? { |object, index| !object.equal?(at(index)) }
+        return self unless changed
+        owner.mark_project_as_dirty!
+        self[0, count] = sorted
+        self
+      end
+
       # @!group Notification Methods
       #------------------------------------------------------------------------#
 
@@ -195,15 +315,29 @@ module Xcodeproj
       # the owner of the list as referrer to the objects. It also validates the
       # value.
       #
+      # @note   As the validation only depends on the class of the objects,
+      #         it is performed once per class before any referrer is added.
+      #         It is deferred while a transaction is in progress, see
+      #         {Transaction#validate_later}.
+      #
       # @return [void]
       #
       def perform_additions_operations(objects)
         objects = [objects] unless objects.is_a?(Array)
+        return if objects.empty?
+        transaction = owner.project.current_transaction
+        validated_classes = {}
         objects.each do |obj|
-          owner.mark_project_as_dirty!
-          obj.add_referrer(owner)
-          attribute.validate_value(obj) unless obj.is_a?(ObjectDictionary)
+          next if obj.is_a?(ObjectDictionary) || validated_classes.key?(obj.class)
+          if transaction
+            transaction.validate_later(attribute, obj)
+          else
+            attribute.validate_value(obj)
+          end
+          validated_classes[obj.class] = true
         end
+        owner.mark_project_as_dirty!
+        objects.each { |obj| obj.add_referrer(owner) }
       end
 
       # Informs an object that it was removed from to the list, so it can
@@ -213,8 +347,9 @@ module Xcodeproj
       #
       def perform_deletion_operations(objects)
         objects = [objects] unless objects.is_a?(Array)
+        return if objects.empty?
+        owner.mark_project_as_dirty!
         objects.each do |obj|
-          owner.mark_project_as_dirty!
           obj.remove_referrer(owner) unless obj.is_a?(ObjectDictionary)
         end
       end
@@ -0,0 +1,264 @@
+require 'atomos'
+require 'digest'
+require 'fileutils'
+
+module Xcodeproj
+  class Project
+    # An on-disk cache of the parsed `project.pbxproj` files, which allows
+    # {Project.open} to skip parsing a file which has already been parsed,
+    # for example by a previous process of the same CI job.
+    #
+    # A snapshot is stored for each version of a file, keyed by the digest of
+    # its contents, of the version of Xcodeproj and of the format of the
+    # snapshots. A snapshot is a compact binary encoding of the objects of the
+    # file:
+    #
+    # - the ISAs of the objects are stored once, in a table;
+    # - the other strings are interned in a table and referenced by index;
+    # - the references to other objects are stored as the index of their
+    #   UUID in the table of the objects.
+    #
+    # The decoded contents are equal to the parsed ones and every string is
+    # a distinct object, as with the parser, so they can be mutated safely.
+    #
+    # @note   The snapshots are loaded with `Marshal`, so the cache directory
+    #         should only be writable by trusted processes. The directory is
+    #         never pruned.
+    #
+    class SnapshotCache
+      # @return [Integer] The version of the encoding of the snapshots, part
+      #         of their key.
+      #
+      FORMAT_VERSION = 1
+
+      # @return [String] The extension of the snapshot files.
+      #
+      EXTENSION = '.pbxproj-snapshot'.freeze
+
+      # @return [Pathname] The directory of the snapshots.
+      #
+      attr_reader :directory
+
+      # @param  [#to_s] directory
+      #         The directory of the snapshots, created if needed.
+      #
+      def initialize(directory)
+        @directory = Pathname.new(directory.to_s).expand_path
+      end
+
+      # Returns the contents of the given `project.pbxproj` file, loaded from
+      # its snapshot if there is one, parsed otherwise. A snapshot is stored
+      # after parsing the file.
+      #
+      # @param  [#to_s] pbxproj_path
+      #         The path of the file.
+      #
+      # @param  [Project] project
+      #         The project being opened, the subject of the instrumentation
+      #         events.
+      #
+      # @return [Hash] The contents of the file.
+      #
+      def fetch(pbxproj_path, project = nil)
+        contents = Plist.read_contents(pbxproj_path)
+        digest = digest(contents)
+        plist = Instrumentation.instrument('project.open.snapshot.read', project) { read(digest) }
+        return plist if plist
+
+        plist = Instrumentation.instrument('project.open.parse', project) do
+          Plist.read_from_contents(contents, pbxproj_path)
+        end
+        Instrumentation.instrument('project.open.snapshot.write', project) { write(digest, plist) }
+        plist
+      end
+
+      # @param  [String] contents
+      #         The contents of a `project.pbxproj` file.
+      #
+      # @return [String] The key of the snapshot of the given contents.
+      #
+      def digest(contents)
+        sha = Digest::SHA256.new
+        sha << VERSION << "\0" << FORMAT_VERSION.to_s << "\0" << contents
+        sha.hexdigest
+      end
+
+      # @param  [String] digest
+      #         The key of the snapshot.
+      #
+      # @return [Hash] The contents stored in the snapshot with the given key.
+      # @return [Nil] If there is no such snapshot or if it can't be read.
+      #
+      def read(digest)
+        path = snapshot_path(digest)
+        return unless path.file?
+        payload = Marshal.load(File.binread(path))
+        return unless payload.is_a?(Array) && payload[0] == FORMAT_VERSION && payload[1] == digest
+        Decoder.new(payload).decode
+      rescue StandardError
+        nil
+      end
+
+      # Stores the given contents in the snapshot with the given key, unless
+      # they include values which can't be encoded, i.e. which are not
+      # strings, arrays or hashes, or the cache directory can't be written.
+      #
+      # @param  [String] digest
+      #         The key of the snapshot.
+      #
+      # @param  [Hash] plist
+      #         The contents of a `project.pbxproj` file.
+      #
+      # @return [Bool] Whether the snapshot has been written.
+      #
+      def write(digest, plist)
+        payload = Encoder.new(plist).encode
+        return false unless payload
+        FileUtils.mkdir_p(directory)
+        Atomos.atomic_write(snapshot_path(digest).to_s) do |f|
+          f.binmode
+          f.write(Marshal.dump([FORMAT_VERSION, digest].concat(payload)))
+        end
+        true
+      rescue SystemCallError, IOError
+        false
+      end
+
+      private
+
+      # @return [Pathname] The path of the snapshot with the given key.
+      #
+      def snapshot_path(digest)
+        directory + "#{digest}#{EXTENSION}"
+      end
+
+      # Encodes the contents of a `project.pbxproj` file as tables of
+      # integers and strings.
+      #
+      class Encoder
+        # @param  [Hash] plist
+        #         The contents of the file.
+        #
+        def initialize(plist)
+          @plist = plist
+          @strings = {}
+          @isas = {}
+          @uuids = {}
+        end
+
+        # @return [Array] The ISA table, the strings table, the UUIDs table,
+        #         the records of the objects and the other keys of the file.
+        # @return [Nil] If the contents can't be encoded.
+        #
+        def encode
+          objects = @plist['objects']
+          return unless objects.is_a?(Hash)
+          objects.each_key { |uuid| @uuids[uuid] = @uuids.size }
+          records = objects.map { |_, attributes| encode_object(attributes) }
+          others = @plist.map { |key, value| [key, key == 'objects' ? nil : encode_value(value)] }
+          [@isas.keys, @strings.keys, @uuids.keys, records, others]
+        rescue TypeError
+          nil
+        end
+
+        private
+
+        # @return [Array] The index of the ISA of an object, nil if it is
+        #         not the first attribute, followed by the indexes of the
+        #         keys and the encoded values of the other attributes.
+        #
+        def encode_object(attributes)
+          raise TypeError unless attributes.is_a?(Hash)
+          record = [nil]
+          attributes.each_with_index do |(key, value), index|
+            if index.zero? && key == 'isa' && value.is_a?(String)
+              record[0] = (@isas[value] ||= @isas.size)
+            else
+              record << string_index(key) << encode_value(value)
+            end
+          end
+          record
+        end
+
+        # @return [Integer, Array, Hash] The index of a string, or the
+        #         negative index, minus one, of the UUID of a referenced
+        #         object.
+        #
+        def encode_value(value)
+          case value
+          when String
+            uuid_index = @uuids[value]
+            uuid_index ? -uuid_index - 1 : string_index(value)
+          when Array
+            value.map { |element| encode_value(element) }
+          when Hash
+            hash = {}
+            value.each { |key, element| hash[string_index(key)] = encode_value(element) }
+            hash
+          else
+            raise TypeError
+          end
+        end
+
+        # @return [Integer] The index of the given string in the table.
+        #
+        def string_index(string)
+          raise TypeError unless string.is_a?(String)
+          @strings[string] ||= @strings.size
+        end
+      end
+
+      # Decodes the tables produced by {Encoder}.
+      #
+      class Decoder
+        # @param  [Array] payload
+        #         The contents of a snapshot.
+        #
+        def initialize(payload)
+          _, _, @isas, @strings, @uuids, @records, @others = payload
+          @isas.each(&:freeze)
+          @strings.each(&:freeze)
+          @uuids.each(&:freeze)
+        end
+
+        # @return [Hash] The contents of the `project.pbxproj` file.
+        #
+        def decode
+          objects = {}
+          @records.each_with_index do |record, index|
+            isa = record[0]
+            attributes = isa ? { 'isa' => @isas[isa].dup } : {}
+            position = 1
+            while position < record.length
+              attributes[@strings[record[position]]] = decode_value(record[position + 1])
+              position += 2
+            end
+            objects[@uuids[index]] = attributes
+          end
+          plist = {}
+          @others.each { |key, value| plist[key] = key == 'objects' ? objects : decode_value(value) }
+          plist
+        end
+
+        private
+
+        # @return [String, Array, Hash] The decoded value, with new strings.
+        #
+        def decode_value(value)
+          case value
+          when Integer
+            value < 0 ? @uuids[-value - 1].dup : @strings[value].dup
+          when Array
+            value.map { |element| decode_value(element) }
+          else
+            hash = {}
+            value.each { |key, element| hash[@strings[key]] = decode_value(element) }
+            hash
+          end
+        end
+      end
+
+      private_constant :Encoder, :Decoder
+    end
+  end
+end
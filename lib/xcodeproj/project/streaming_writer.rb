@@ -0,0 +1,190 @@
+module Xcodeproj
+  class Project
+    # Writes the `project.pbxproj` file of a project directly from its
+    # objects to an IO.
+    #
+    # Unlike serializing {Project#to_ascii_plist} with Nanaimo, the objects
+    # dictionary of the whole project is never built: the objects are grouped
+    # by ISA in a single pass and each one is written as soon as its
+    # representation is available. The representation of the objects and of
+    # their values is still delegated to Nanaimo, so the output is identical
+    # to the one of `Nanaimo::Writer::PBXProjWriter`.
+    #
+    class StreamingWriter
+      # @param  [Project] project
+      #         The project to write.
+      #
+      # @param  [#<<] output
+      #         The IO (or String) which receives the contents.
+      #
+      def initialize(project, output)
+        @project = project
+        @output = output
+        @buffer = String.new
+        @fragment_writer = FragmentWriter.new(nil, :pretty => true, :output => @buffer, :strict => false)
+        @instrumented = Instrumentation.subscribed?
+        @serialization_duration = 0.0
+        @serialization_allocations = 0
+      end
+
+      # Writes the project.
+      #
+      # If there is any subscriber to the {Instrumentation}, the time spent
+      # building the representations of the objects and the time spent
+      # writing them are published as the `project.save.serialize` and the
+      # `project.save.write` phases.
+      #
+      # @return [void]
+      #
+      def write
+        return write_contents unless @instrumented
+        start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        allocations = GC.stat(:total_allocated_objects)
+        write_contents
+        duration = Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+        allocations = GC.stat(:total_allocated_objects) - allocations
+        Instrumentation.publish('project.save.serialize', @serialization_duration, @serialization_allocations, @project)
+        Instrumentation.publish('project.save.write', duration - @serialization_duration, allocations - @serialization_allocations, @project)
+      end
+
+      private
+
+      # @!group Private helpers
+      #-----------------------------------------------------------------------#
+
+      # Writes the contents of the file.
+      #
+      # @return [void]
+      #
+      def write_contents
+        @output << "// !$*UTF8*$!\n{\n"
+        write_pair('archiveVersion', @project.archive_version.to_s, 1)
+        write_pair('classes', @project.classes, 1)
+        write_pair('objectVersion', @project.object_version.to_s, 1)
+        write_objects
+        root_object = @project.root_object
+        write_pair('rootObject', Nanaimo::String.new(root_object.uuid, root_object.ascii_plist_annotation), 1)
+        @output << "}\n"
+      end
+
+      # Writes the objects section, with an ISA section for each class of
+      # objects. The representation of the objects is cached only once all
+      # of them have been written, see {AbstractObject#cache_ascii_plist}.
+      #
+      # @return [void]
+      #
+      def write_objects
+        @project.refresh_ascii_plist_caches
+        buckets = Hash.new { |hash, isa| hash[isa] = [] }
+        @project.objects_by_uuid.each_value { |object| buckets[object.isa] << object }
+
+        uncached = []
+        @output << "\tobjects = {\n"
+        buckets.keys.sort.each do |isa|
+          @output << "\n/* Begin #{isa} section */\n"
+          buckets[isa].sort_by!(&:uuid).each do |object|
+            key = Nanaimo::String.new(object.uuid, object.ascii_plist_annotation)
+            unless value = object.cached_ascii_plist
+              value = serialize(object)
+              uncached << [object, value]
+            end
+            write_pair(key, value, 2)
+          end
+          @output << "/* End #{isa} section */\n"
+        end
+        @output << "\t};\n"
+        uncached.each { |object, value| object.cache_ascii_plist(value) }
+      end
+
+      # @return [Nanaimo::Dictionary] The representation of the given object,
+      #         measured as the `project.save.serialize` phase of the
+      #         instrumentation, see {Instrumentation}.
+      #
+      def serialize(object)
+        return object.to_ascii_plist.tap { |a| a.annotation = nil } unless @instrumented
+        start = Process.clock_gettime(Process::CLOCK_MONOTONIC)
+        allocations = GC.stat(:total_allocated_objects)
+        value = object.to_ascii_plist.tap { |a| a.annotation = nil }
+        @serialization_duration += Process.clock_gettime(Process::CLOCK_MONOTONIC) - start
+        @serialization_allocations += GC.stat(:total_allocated_objects) - allocations
+        value
+      end
+
+      # Writes a key value pair of a dictionary.
+      #
+      # @param  [Nanaimo::String, String] key
+      #
+      # @param  [Nanaimo::Object, Object] value
+      #
+      # @param  [Integer] depth
+      #         The indentation level of the pair.
+      #
+      # @return [void]
+      #
+      def write_pair(key, value, depth)
+        indentation = "\t" * depth
+        @output << indentation << fragment(key) << ' = ' << indent(fragment(value), indentation) << ";\n"
+      end
+
+      # @return [String] The representation of the given value at the top
+      #         level of the file.
+      #
+      def fragment(value)
+        @buffer.clear
+        @fragment_writer.write_fragment(value)
+        @buffer.dup
+      end
+
+      # @return [String] The given fragment with each of its lines, but the
+      #         first one, indented by the given prefix. Nanaimo escapes the
+      #         newlines of the strings, so the only ones of a fragment
+      #         separate the entries of arrays and dictionaries.
+      #
+      def indent(fragment, indentation)
+        return fragment unless fragment.include?("\n")
+        fragment.gsub("\n", "\n#{indentation}")
+      end
+
+      # An output which forwards the contents to an IO and to a digest, so
+      # the contents can be written and digested in a single pass.
+      #
+      class DigestingOutput
+        # @param  [#<<] io
+        #         The IO which receives the contents.
+        #
+        # @param  [Digest::Base] digest
+        #         The digest which receives the contents.
+        #
+        def initialize(io, digest)
+          @io = io
+          @digest = digest
+        end
+
+        # @param  [String] string
+        #         The contents to append.
+        #
+        # @return [DigestingOutput] The output.
+        #
+        def <<(string)
+          @io << string
+          @digest << string
+          self
+        end
+      end
+
+      # Exposes the serialization of a single value of the PBXProj flavour
+      # of the ASCII plist writer of Nanaimo.
+      #
+      class FragmentWriter < Nanaimo::Writer::PBXProjWriter
+        # @param  [Nanaimo::Object, Object] value
+        #         The value to append to the output of the writer.
+        #
+        # @return [void]
+        #
+        def write_fragment(value)
+          write_object(value)
+        end
+      end
+    end
+  end
+end
@@ -0,0 +1,150 @@
+module Xcodeproj
+  class Project
+    # A batch of modifications of the objects of a project, see
+    # {Project#transaction}.
+    #
+    # While a transaction is in progress the bookkeeping which follows each
+    # modification is deferred:
+    #
+    # - the values assigned to the attributes and added to the lists are
+    #   type checked on commit, once per attribute and class of value;
+    # - the modified objects are marked as changed, which discards their
+    #   cached serialization and schedules their incremental sort, once,
+    #   on commit or before the project is serialized, sorted or asked
+    #   whether it is dirty;
+    # - the updates of the {ObjectIndex} are coalesced and applied on the
+    #   next query of the index.
+    #
+    # Before an object is modified for the first time its state is recorded
+    # in a journal, which allows to restore the objects if the transaction
+    # is rolled back.
+    #
+    # @visibility private
+    #
+    class Transaction
+      # @param  [Project] project
+      #         The project whose objects are modified.
+      #
+      def initialize(project)
+        @project = project
+        @journal = {}.compare_by_identity
+        @changed = {}.compare_by_identity
+        @values_to_validate = {}.compare_by_identity
+      end
+
+      # @!group Journal
+      #-----------------------------------------------------------------------#
+
+      # Records that the given object has been created by the transaction,
+      # so it has no state to restore.
+      #
+      # @param  [AbstractObject] object
+      #         The new object.
+      #
+      # @return [void]
+      #
+      def object_created(object)
+        @journal[object] = nil
+      end
+
+      # Records the state of the given object, before it is modified for the
+      # first time during the transaction.
+      #
+      # @param  [AbstractObject] object
+      #         The object about to be modified.
+      #
+      # @return [void]
+      #
+      def journal(object)
+        return if @journal.key?(object)
+        @journal[object] = [object.capture_state, @project.loaded_objects_by_uuid[object.uuid].equal?(object)]
+      end
+
+      # Records the state of the given object, if needed, and defers the
+      # bookkeeping of its modification.
+      #
+      # @param  [AbstractObject] object
+      #         The object about to be modified.
+      #
+      # @return [void]
+      #
+      def object_changed(object)
+        journal(object)
+        @changed[object] = true
+      end
+
+      # Defers the type checking of a value assigned to an attribute or added
+      # to a list, unless a value of the same class has already been
+      # deferred for the attribute.
+      #
+      # @param  [AbstractObjectAttribute] attribute
+      #         The attribute.
+      #
+      # @param  [Object] value
+      #         The value.
+      #
+      # @return [void]
+      #
+      def validate_later(attribute, value)
+        return unless value
+        values = (@values_to_validate[attribute] ||= {})
+        values[value.class] = value unless values.key?(value.class)
+      end
+
+      # @!group Completion
+      #-----------------------------------------------------------------------#
+
+      # Marks the objects modified since the last call as changed and the
+      # project as dirty.
+      #
+      # @return [void]
+      #
+      def apply_changes
+        return if @changed.empty?
+        @changed.each_key do |object|
+          object.invalidate_ascii_plist_cache
+          @project.mark_changed_since_sort(object)
+        end
+        @changed.clear
+        @project.mark_dirty!
+      end
+
+      # Type checks the values whose validation has been deferred.
+      #
+      # @raise  If the class of a value is not compatible with its attribute.
+      #
+      # @return [void]
+      #
+      def validate!
+        @values_to_validate.each do |attribute, values|
+          values.each_value { |value| attribute.validate_value(value) }
+        end
+      end
+
+      # Restores the state of the objects recorded in the journal and removes
+      # the objects created by the transaction from the project.
+      #
+      # @note   The cached serialization and the digest of every object are
+      #         discarded, as they might have been computed from the modified
+      #         objects.
+      #
+      # @return [void]
+      #
+      def rollback
+        objects_by_uuid = @project.loaded_objects_by_uuid
+        @journal.each do |object, (state, member)|
+          object.restore_state(state) if state
+          if member
+            objects_by_uuid[object.uuid] = object
+          elsif objects_by_uuid[object.uuid].equal?(object)
+            objects_by_uuid.delete(object.uuid)
+          end
+        end
+        objects_by_uuid.each_value do |object|
+          object.invalidate_ascii_plist_cache
+          object.invalidate_digest
+        end
+      end
+    end
+  end
+end
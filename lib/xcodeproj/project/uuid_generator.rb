@@ -5,23 +5,37 @@ module Xcodeproj
 
       def initialize(projects)
         @projects = Array(projects)
-        @paths_by_object = {}
+        @path_components_by_object = {}.compare_by_identity
+        @uuids_by_object = {}.compare_by_identity
+        @fingerprints = Hash.new { |cache, depth| cache[depth] = {}.compare_by_identity }
+        @tree_hash_entries = {}.compare_by_identity
+        @hierarchy_paths = {}.compare_by_identity
       end
 
       def generate!
-        generate_all_paths_by_objects(@projects)
-
-        new_objects_by_project = Hash[@projects.map do |project|
-          [project, switch_uuids(project)]
-        end]
-        all_new_objects_by_project = new_objects_by_project.values.flat_map(&:values)
-        all_objects_by_uuid = @projects.map(&:objects_by_uuid).inject(:merge)
-        all_objects = @projects.flat_map(&:objects)
-        verify_no_duplicates!(all_objects, all_new_objects_by_project)
-        @projects.each { |project| fixup_uuid_references(project, all_objects_by_uuid) }
-        new_objects_by_project.each do |project, new_objects_by_uuid|
-          project.instance_variable_set(:@generated_uuids, project.instance_variable_get(:@available_uuids))
-          project.instance_variable_set(:@objects_by_uuid, new_objects_by_uuid)
+        @projects.each(&:preserve_all_for_forks)
+        subject = @projects.first if @projects.count == 1
+        Instrumentation.instrument('project.predictabilize_uuids', subject) do
+          Instrumentation.instrument('project.predictabilize_uuids.paths', subject) do
+            generate_all_paths_by_objects(@projects)
+          end
+
+          new_objects_by_project = Instrumentation.instrument('project.predictabilize_uuids.switch', subject) do
+            Hash[@projects.map do |project|
+              [project, switch_uuids(project)]
+            end]
+          end
+          Instrumentation.instrument('project.predictabilize_uuids.fixups', subject) do
+            all_new_objects_by_project = new_objects_by_project.values.flat_map(&:values)
+            all_objects_by_uuid = @projects.map(&:objects_by_uuid).inject(:merge)
+            all_objects = @projects.flat_map(&:objects)
+            verify_no_duplicates!(all_objects, all_new_objects_by_project)
+            @projects.each { |project| fixup_uuid_references(project, all_objects_by_uuid) }
+            new_objects_by_project.each do |project, new_objects_by_uuid|
+              project.instance_variable_set(:@generated_uuids, Set.new(project.instance_variable_get(:@available_uuids)))
+              project.instance_variable_set(:@objects_by_uuid, new_objects_by_uuid)
+            end
+          end
         end
       end
 
@@ -30,9 +44,11 @@ module Xcodeproj
       UUID_ATTRIBUTES = [:remote_global_id_string, :container_portal, :target_proxy].freeze
 
       def verify_no_duplicates!(all_objects, all_new_objects)
-        duplicates = all_objects - all_new_objects
+        new_objects = {}.compare_by_identity
+        all_new_objects.each { |object| new_objects[object] = true }
+        duplicates = all_objects.reject { |object| new_objects.key?(object) }
         UserInterface.warn "[Xcodeproj] Generated duplicate UUIDs:\n\n" <<
-          duplicates.map { |d| "#{d.isa} -- #{@paths_by_object[d]}" }.join("\n") unless duplicates.empty?
+          duplicates.map { |d| "#{d.isa} -- #{path_for_object(d)}" }.join("\n") unless duplicates.empty?
       end
 
       def fixup_uuid_references(target_project, all_objects_by_uuid)
@@ -60,58 +76,155 @@ module Xcodeproj
         end
       end
 
+      # The objects of each project are only reachable from its root object,
+      # so the paths of a project don't depend on the other ones.
+      #
       def generate_all_paths_by_objects(projects)
         projects.each { |project| generate_paths(project.root_object, project.path.basename.to_s) }
       end
 
-      def generate_paths(object, path = '')
-        existing = @paths_by_object[object] || path
-        return existing if @paths_by_object.key?(object)
-        @paths_by_object[object] = path.size > existing.size ? path : existing
+      # The path of an object is the path of the first object from which it
+      # has been reached followed by the component which describes the
+      # relationship. Only the components are stored and the UUID is computed
+      # from the digest of the path of the parent, so the cost doesn't depend
+      # on the length of the paths.
+      #
+      def generate_paths(object, component, parent = nil, parent_digest = Digest::MD5.new)
+        digest = parent_digest.dup << component
+        @path_components_by_object[object] = [parent, component]
+        @uuids_by_object[object] = digest.hexdigest.upcase
 
         object.to_one_attributes.each do |attrb|
           obj = attrb.get_value(object)
-          generate_paths(obj, path + '/' << attrb.plist_name) if obj
+          next if !obj || @path_components_by_object.key?(obj)
+          generate_paths(obj, '/' + attrb.plist_name, object, digest)
         end
 
         object.to_many_attributes.each do |attrb|
           attrb.get_value(object).each do |o|
-            generate_paths(o, path + '/' << attrb.plist_name << "/#{path_component_for_object(o)}")
+            next if @path_components_by_object.key?(o)
+            generate_paths(o, '/' + attrb.plist_name << "/#{path_component_for_object(o)}", object, digest)
           end
         end
 
         object.references_by_keys_attributes.each do |attrb|
           attrb.get_value(object).each do |dictionary|
             dictionary.each do |key, value|
-              generate_paths(value, path + '/' << attrb.plist_name << "/k:#{key}/#{path_component_for_object(value)}")
+              next if @path_components_by_object.key?(value)
+              generate_paths(value, '/' + attrb.plist_name << "/k:#{key}/#{path_component_for_object(value)}", object, digest)
             end
           end
         end
       end
 
+      def path_for_object(object)
+        parent, component = @path_components_by_object[object]
+        parent ? path_for_object(parent) + component : component
+      end
+
       def switch_uuids(project)
         project.mark_dirty!
         project.objects.each_with_object({}) do |object, hash|
-          next unless path = @paths_by_object[object]
-          uuid = uuid_for_path(path)
+          next unless uuid = @uuids_by_object[object]
+          object.invalidate_ascii_plist_cache
+          object.invalidate_digest
           object.instance_variable_set(:@uuid, uuid)
           hash[uuid] = object
         end
       end
 
-      def uuid_for_path(path)
-        Digest::MD5.hexdigest(path).upcase
-      end
-
       def path_component_for_object(object)
         @path_component_for_object ||= Hash.new do |cache, key|
-          component = tree_hash_to_path(key.to_tree_hash)
-          component << key.hierarchy_path.to_s if key.respond_to?(:hierarchy_path)
+          component = fingerprint(key).dup
+          component << hierarchy_path(key).to_s if key.respond_to?(:hierarchy_path)
           cache[key] = component
-        end
+        end.compare_by_identity
         @path_component_for_object[object]
       end
 
+      # Returns the same string as `tree_hash_to_path(object.to_tree_hash,
+      # depth)` without building the tree hash of the whole graph reachable
+      # from the object. Only the levels up to the given depth are visited and
+      # the fingerprint of each object is computed once per depth.
+      #
+      def fingerprint(object, depth = 4)
+        return '|' if depth.zero?
+        @fingerprints[depth][object] ||= begin
+          entries = tree_hash_entries(object)
+          entries ? hash_to_path(entries, depth) : tree_hash_to_path(object.to_tree_hash, depth)
+        end
+      end
+
+      # @return [Hash] The entries of the tree hash of the object, with the
+      #         referenced objects in place of their tree hashes.
+      # @return [Nil] If the object uses a custom tree hash.
+      #
+      def tree_hash_entries(object)
+        return @tree_hash_entries[object] if @tree_hash_entries.key?(object)
+        @tree_hash_entries[object] = compute_tree_hash_entries(object)
+      end
+
+      def compute_tree_hash_entries(object)
+        owner = object.method(:to_tree_hash).owner
+        if owner == Object::AbstractObject
+          hash = { 'displayName' => object.display_name, 'isa' => object.isa }
+          object.simple_attributes.each do |attrb|
+            value = attrb.get_value(object)
+            hash[attrb.plist_name] = value if value
+          end
+          object.to_one_attributes.each do |attrb|
+            obj = attrb.get_value(object)
+            hash[attrb.plist_name] = obj if obj
+          end
+          (object.to_many_attributes + object.references_by_keys_attributes).each do |attrb|
+            hash[attrb.plist_name] = attrb.get_value(object)
+          end
+          hash
+        elsif owner == Object::PBXTargetDependency
+          hash = { 'displayName' => object.display_name, 'isa' => object.isa }
+          hash['targetProxy'] = object.target_proxy if object.target_proxy
+          hash
+        end
+      end
+
+      def value_to_path(value, depth)
+        return '|' if depth.zero?
+        case value
+        when Object::AbstractObject
+          fingerprint(value, depth)
+        when ObjectDictionary
+          entries = {}
+          value.each do |key, obj|
+            entries[Object::CaseConverter.convert_to_plist(key, nil)] = obj if obj
+          end
+          hash_to_path(entries, depth)
+        when Hash
+          hash_to_path(value, depth)
+        when Array
+          value.map { |v| value_to_path(v, depth - 1) }.join(',')
+        else
+          value.to_s
+        end
+      end
+
+      def hash_to_path(hash, depth)
+        hash.sort_by(&:first).each_with_object('') do |(key, value), string|
+          string << key << ':' << value_to_path(value, depth - 1) << ','
+        end
+      end
+
+      # Returns the same string as the `hierarchy_path` of the object,
+      # reusing the hierarchy path of its parent.
+      #
+      def hierarchy_path(object)
+        return @hierarchy_paths[object] if @hierarchy_paths.key?(object)
+        @hierarchy_paths[object] = unless Object::GroupableHelper.main_group?(object)
+                                     parent = Object::GroupableHelper.parent(object)
+                                     parent = hierarchy_path(parent) if parent.respond_to?(:hierarchy_path)
+                                     "#{parent}/#{object.display_name}"
+                                   end
+      end
+
       def tree_hash_to_path(object, depth = 4)
         return '|' if depth.zero?
         case object
@@ -15,6 +15,7 @@ require 'xcodeproj/scheme/macro_expansion'
 require 'xcodeproj/scheme/remote_runnable'
 require 'xcodeproj/scheme/send_email_action_content'
 require 'xcodeproj/scheme/shell_script_action_content'
+require 'xcodeproj/scheme/xml_serializer'
 
 module Xcodeproj
   # This class represents a Scheme document represented by a ".xcscheme" file
@@ -36,7 +37,7 @@ module Xcodeproj
       if file_path
         @file_path = file_path
         @doc = File.open(file_path, 'r') do |f|
-          REXML::Document.new(f)
+          REXML::Document.new(f, :ignore_whitespace_nodes => :all)
         end
         @doc.context[:attribute_quote] = :quote
 
@@ -92,15 +93,14 @@ module Xcodeproj
     #         The Build Action associated with this scheme
     #
     def build_action
-      @build_action ||= BuildAction.new(@scheme.elements['BuildAction'])
+      @build_action ||= BuildAction.new(action_element('BuildAction'))
     end
 
     # @param [XCScheme::BuildAction] action
     #        The Build Action to associate to this scheme
     #
     def build_action=(action)
-      @scheme.delete_element('BuildAction')
-      @scheme.add_element(action.xml_element)
+      replace_action_element('BuildAction', action)
       @build_action = action
     end
 
@@ -108,15 +108,14 @@ module Xcodeproj
     #         The Test Action associated with this scheme
     #
     def test_action
-      @test_action ||= TestAction.new(@scheme.elements['TestAction'])
+      @test_action ||= TestAction.new(action_element('TestAction'))
     end
 
     # @param [XCScheme::TestAction] action
     #        The Test Action to associate to this scheme
     #
     def test_action=(action)
-      @scheme.delete_element('TestAction')
-      @scheme.add_element(action.xml_element)
+      replace_action_element('TestAction', action)
       @test_action = action
     end
 
@@ -124,15 +123,14 @@ module Xcodeproj
     #         The Launch Action associated with this scheme
     #
     def launch_action
-      @launch_action ||= LaunchAction.new(@scheme.elements['LaunchAction'])
+      @launch_action ||= LaunchAction.new(action_element('LaunchAction'))
     end
 
     # @param [XCScheme::LaunchAction] action
     #        The Launch Action to associate to this scheme
     #
     def launch_action=(action)
-      @scheme.delete_element('LaunchAction')
-      @scheme.add_element(action.xml_element)
+      replace_action_element('LaunchAction', action)
       @launch_action = action
     end
 
@@ -140,15 +138,14 @@ module Xcodeproj
     #         The Profile Action associated with this scheme
     #
     def profile_action
-      @profile_action ||= ProfileAction.new(@scheme.elements['ProfileAction'])
+      @profile_action ||= ProfileAction.new(action_element('ProfileAction'))
     end
 
     # @param [XCScheme::ProfileAction] action
     #        The Profile Action to associate to this scheme
     #
     def profile_action=(action)
-      @scheme.delete_element('ProfileAction')
-      @scheme.add_element(action.xml_element)
+      replace_action_element('ProfileAction', action)
       @profile_action = action
     end
 
@@ -156,15 +153,14 @@ module Xcodeproj
     #         The Analyze Action associated with this scheme
     #
     def analyze_action
-      @analyze_action ||= AnalyzeAction.new(@scheme.elements['AnalyzeAction'])
+      @analyze_action ||= AnalyzeAction.new(action_element('AnalyzeAction'))
     end
 
     # @param [XCScheme::AnalyzeAction] action
     #        The Analyze Action to associate to this scheme
     #
     def analyze_action=(action)
-      @scheme.delete_element('AnalyzeAction')
-      @scheme.add_element(action.xml_element)
+      replace_action_element('AnalyzeAction', action)
       @analyze_action = action
     end
 
@@ -172,15 +168,14 @@ module Xcodeproj
     #         The Archive Action associated with this scheme
     #
     def archive_action
-      @archive_action ||= ArchiveAction.new(@scheme.elements['ArchiveAction'])
+      @archive_action ||= ArchiveAction.new(action_element('ArchiveAction'))
     end
 
     # @param [XCScheme::ArchiveAction] action
     #        The Archive Action to associate to this scheme
     #
     def archive_action=(action)
-      @scheme.delete_element('ArchiveAction')
-      @scheme.add_element(action.xml_element)
+      replace_action_element('ArchiveAction', action)
       @archive_action = action
     end
 
@@ -232,6 +227,29 @@ module Xcodeproj
       test_action.add_macro_expansion(macro_exp)
     end
 
+    private
+
+    # @return [REXML::Element] the element of the scheme with the given
+    #         name, looked up among the children of the scheme without the
+    #         cost of an XPath query.
+    #
+    def action_element(name)
+      @scheme.each_element { |element| return element if element.name == name }
+      nil
+    end
+
+    # Replaces the element of an action of the scheme.
+    #
+    # @return [void]
+    #
+    def replace_action_element(name, action)
+      element = action_element(name)
+      @scheme.delete_element(element) if element
+      @scheme.add_element(action.xml_element)
+    end
+
+    public
+
     # @!group Class methods
 
     #-------------------------------------------------------------------------#
@@ -285,15 +303,23 @@ module Xcodeproj
     # @return [String] the XML string value of the current state of the object.
     #
     def to_s
-      formatter = XMLFormatter.new(2)
-      formatter.compact = false
-      out = ''
-      formatter.write(@doc, out)
-      out.gsub!("<?xml version='1.0' encoding='UTF-8'?>", '<?xml version="1.0" encoding="UTF-8"?>')
-      out << "\n"
+      out = String.new
+      write(out)
       out
     end
 
+    # Serializes the current state of the object to the given IO.
+    #
+    # @param  [#<<] output
+    #         The IO or the String which receives the XML.
+    #
+    # @return [void]
+    #
+    def write(output)
+      XMLSerializer.new(output).write_document(@doc)
+      output << "\n"
+    end
+
     # Serializes the current state of the object to a ".xcscheme" file.
     #
     # @param [String, Pathname] project_path
@@ -306,10 +332,10 @@ module Xcodeproj
     #        true  => if the scheme must be a shared scheme (default value)
     #        false => if the scheme must be a user scheme
     #
-    # @return [void]
+    # @return [Integer] the number of bytes written.
     #
     # @example Saving a scheme
-    #   scheme.save_as('path/to/Project.xcodeproj') #=> true
+    #   scheme.save_as('path/to/Project.xcodeproj', 'App')
     #
     def save_as(project_path, name, shared = true)
       scheme_folder_path = if shared
@@ -320,9 +346,7 @@ module Xcodeproj
       scheme_folder_path.mkpath
       scheme_path = scheme_folder_path + "#{name}.xcscheme"
       @file_path = scheme_path
-      File.open(scheme_path, 'w') do |f|
-        f.write(to_s)
-      end
+      write_to_path(scheme_path)
     end
 
     # Serializes the current state of the object to the original ".xcscheme"
@@ -330,19 +354,56 @@ module Xcodeproj
     #
     # Requires that the XCScheme object was initialized using a file path.
     #
+    # @return [Integer] the number of bytes written.
+    #
     def save!
       raise Informative, 'This XCScheme object was not initialized ' \
         'using a file path. Use save_as instead.' unless @file_path
-      File.open(@file_path, 'w') do |f|
-        f.write(to_s)
+      write_to_path(@file_path)
+    end
+
+    private
+
+    # Serializes the current state of the object to the file at the given
+    # path.
+    #
+    # @param  [String, Pathname] path
+    #         The path of the file.
+    #
+    # @return [Integer] the number of bytes written.
+    #
+    def write_to_path(path)
+      File.open(path, 'w') do |f|
+        write(f)
+        f.tell
       end
     end
 
+    public
+
     #-------------------------------------------------------------------------#
 
     # XML formatter which closely mimics the output generated by Xcode.
     #
     class XMLFormatter < REXML::Formatters::Pretty
+      # Writes a node at the given indentation level.
+      #
+      # @param  [REXML::Child] node
+      #         The node to write.
+      #
+      # @param  [#<<] output
+      #         The IO or the String which receives the XML.
+      #
+      # @param  [Integer] level
+      #         The number of spaces of the indentation of the node.
+      #
+      # @return [void]
+      #
+      def write_at_level(node, output, level)
+        @level = level
+        write(node, output)
+      end
+
       def write_element(node, output)
         @indentation = 3
         output << ' ' * @level
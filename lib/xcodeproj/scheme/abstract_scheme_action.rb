@@ -29,7 +29,7 @@ module Xcodeproj
       #         Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def pre_actions
-        pre_actions = @xml_element.elements['PreActions']
+        pre_actions = child_element('PreActions')
         return nil unless pre_actions
         pre_actions.get_elements('ExecutionAction').map do |entry_node|
           ExecutionAction.new(entry_node)
@@ -41,7 +41,7 @@ module Xcodeproj
       #         Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def pre_actions=(pre_actions)
-        @xml_element.delete_element('PreActions')
+        delete_child_element('PreActions')
         unless pre_actions.empty?
           pre_actions_element = @xml_element.add_element('PreActions')
           pre_actions.each do |entry_node|
@@ -56,7 +56,7 @@ module Xcodeproj
       #        It can be either a 'Run Script' or a 'Send Email' action.
       #
       def add_pre_action(pre_action)
-        pre_actions = @xml_element.elements['PreActions'] || @xml_element.add_element('PreActions')
+        pre_actions = child_element('PreActions') || @xml_element.add_element('PreActions')
         pre_actions.add_element(pre_action.xml_element)
       end
 
@@ -65,7 +65,7 @@ module Xcodeproj
       #         Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def post_actions
-        post_actions = @xml_element.elements['PostActions']
+        post_actions = child_element('PostActions')
         return nil unless post_actions
         post_actions.get_elements('ExecutionAction').map do |entry_node|
           ExecutionAction.new(entry_node)
@@ -77,7 +77,7 @@ module Xcodeproj
       #        Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def post_actions=(post_actions)
-        @xml_element.delete_element('PostActions')
+        delete_child_element('PostActions')
         unless post_actions.empty?
           post_actions_element = @xml_element.add_element('PostActions')
           post_actions.each do |entry_node|
@@ -92,7 +92,7 @@ module Xcodeproj
       #        It can be either a 'Run Script' or a 'Send Email' action.
       #
       def add_post_action(post_action)
-        post_actions = @xml_element.elements['PostActions'] || @xml_element.add_element('PostActions')
+        post_actions = child_element('PostActions') || @xml_element.add_element('PostActions')
         post_actions.add_element(post_action.xml_element)
       end
     end
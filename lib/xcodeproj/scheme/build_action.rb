@@ -66,7 +66,7 @@ module Xcodeproj
       #         Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def pre_actions
-        pre_actions = @xml_element.elements['PreActions']
+        pre_actions = child_element('PreActions')
         return nil unless pre_actions
         pre_actions.get_elements('ExecutionAction').map do |entry_node|
           ExecutionAction.new(entry_node)
@@ -78,7 +78,7 @@ module Xcodeproj
       #        Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def pre_actions=(pre_actions)
-        @xml_element.delete_element('PreActions')
+        delete_child_element('PreActions')
         unless pre_actions.empty?
           pre_actions_element = @xml_element.add_element('PreActions')
           pre_actions.each do |entry_node|
@@ -93,7 +93,7 @@ module Xcodeproj
       #        It can be either a 'Run Script' or a 'Send Email' action.
       #
       def add_pre_action(pre_action)
-        pre_actions = @xml_element.elements['PreActions'] || @xml_element.add_element('PreActions')
+        pre_actions = child_element('PreActions') || @xml_element.add_element('PreActions')
         pre_actions.add_element(pre_action.xml_element)
       end
 
@@ -102,7 +102,7 @@ module Xcodeproj
       #         Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def post_actions
-        post_actions = @xml_element.elements['PostActions']
+        post_actions = child_element('PostActions')
         return nil unless post_actions
         post_actions.get_elements('ExecutionAction').map do |entry_node|
           ExecutionAction.new(entry_node)
@@ -114,7 +114,7 @@ module Xcodeproj
       #        Each entry can be either a 'Run Script' or a 'Send Email' action.
       #
       def post_actions=(post_actions)
-        @xml_element.delete_element('PostActions')
+        delete_child_element('PostActions')
         unless post_actions.empty?
           post_actions_element = @xml_element.add_element('PostActions')
           post_actions.each do |entry_node|
@@ -129,7 +129,7 @@ module Xcodeproj
       #        It can be either a 'Run Script' or a 'Send Email' action.
       #
       def add_post_action(post_action)
-        post_actions = @xml_element.elements['PostActions'] || @xml_element.add_element('PostActions')
+        post_actions = child_element('PostActions') || @xml_element.add_element('PostActions')
         post_actions.add_element(post_action.xml_element)
       end
 
@@ -138,7 +138,7 @@ module Xcodeproj
       #         Each entry represent a target to build and tells for which action it's needed to be built.
       #
       def entries
-        entries = @xml_element.elements['BuildActionEntries']
+        entries = child_element('BuildActionEntries')
         return nil unless entries
         entries.get_elements('BuildActionEntry').map do |entry_node|
           BuildAction::Entry.new(entry_node)
@@ -149,7 +149,7 @@ module Xcodeproj
       #        Sets the list of BuildActionEntry nodes associated with this Build Action.
       #
       def entries=(entries)
-        @xml_element.delete_element('BuildActionEntries')
+        delete_child_element('BuildActionEntries')
         unless entries.empty?
           entries_element = @xml_element.add_element('BuildActionEntries')
           entries.each do |entry_node|
@@ -163,7 +163,7 @@ module Xcodeproj
       #        The BuildActionEntry to add to the list of targets to build for the various actions
       #
       def add_entry(entry)
-        entries = @xml_element.elements['BuildActionEntries'] || @xml_element.add_element('BuildActionEntries')
+        entries = child_element('BuildActionEntries') || @xml_element.add_element('BuildActionEntries')
         entries.add_element(entry.xml_element)
       end
 
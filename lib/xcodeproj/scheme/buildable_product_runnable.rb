@@ -39,14 +39,14 @@ module Xcodeproj
       #         The Buildable Reference this Buildable Product Runnable is gonna build and run
       #
       def buildable_reference
-        @buildable_reference ||= BuildableReference.new @xml_element.elements['BuildableReference']
+        @buildable_reference ||= BuildableReference.new child_element('BuildableReference')
       end
 
       # @param [BuildableReference] ref
       #        Set the Buildable Reference this Buildable Product Runnable is gonna build and run
       #
       def buildable_reference=(ref)
-        @xml_element.delete_element('BuildableReference')
+        delete_child_element('BuildableReference')
         @xml_element.add_element(ref.xml_element)
         @buildable_reference = ref
       end
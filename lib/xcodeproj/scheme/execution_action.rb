@@ -39,9 +39,9 @@ module Xcodeproj
       def action_content
         case action_type
         when Constants::EXECUTION_ACTION_TYPE[:shell_script]
-          ShellScriptActionContent.new(@xml_element.elements['ActionContent'])
+          ShellScriptActionContent.new(child_element('ActionContent'))
         when Constants::EXECUTION_ACTION_TYPE[:send_email]
-          SendEmailActionContent.new(@xml_element.elements['ActionContent'])
+          SendEmailActionContent.new(child_element('ActionContent'))
         else
           raise "[Xcodeproj] Invalid ActionType `#{action_type}`"
         end
@@ -55,7 +55,7 @@ module Xcodeproj
         raise "[Xcodeproj] Invalid ActionContent `#{value.class}` for " \
           "ActionType `#{action_type}`" unless valid_action_content?(value)
 
-        @xml_element.delete_element('ActionContent')
+        delete_child_element('ActionContent')
         @xml_element.add_element(value.xml_element)
       end
 
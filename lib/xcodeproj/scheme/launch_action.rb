@@ -51,14 +51,14 @@ module Xcodeproj
       #         The LocationScenarioReference to simulate a GPS location when executing the Launch Action
       #
       def location_scenario_reference?
-        LocationScenarioReference.new(@xml_element.elements['LocationScenarioReference'])
+        LocationScenarioReference.new(child_element('LocationScenarioReference'))
       end
 
       # @return [LocationScenarioReference]
       #         Set the LocationScenarioReference which simulates a GPS location when executing the Launch Action
       #
       def location_scenario_reference=(reference)
-        @xml_element.delete_element('LocationScenarioReference')
+        delete_child_element('LocationScenarioReference')
         @xml_element.add_element(reference.xml_element) if reference
       end
 
@@ -114,14 +114,14 @@ module Xcodeproj
       #         The BuildReference to launch when executing the Launch Action
       #
       def buildable_product_runnable
-        BuildableProductRunnable.new(@xml_element.elements['BuildableProductRunnable'], 0)
+        BuildableProductRunnable.new(child_element('BuildableProductRunnable'), 0)
       end
 
       # @param [BuildableProductRunnable] runnable
       #        Set the BuildableProductRunnable referencing the target to launch
       #
       def buildable_product_runnable=(runnable)
-        @xml_element.delete_element('BuildableProductRunnable')
+        delete_child_element('BuildableProductRunnable')
         @xml_element.add_element(runnable.xml_element) if runnable
       end
 
@@ -129,14 +129,14 @@ module Xcodeproj
       #         Returns the EnvironmentVariables that will be defined at app launch
       #
       def environment_variables
-        EnvironmentVariables.new(@xml_element.elements[XCScheme::VARIABLES_NODE])
+        EnvironmentVariables.new(child_element(XCScheme::VARIABLES_NODE))
       end
 
       # @param [EnvironmentVariables,nil] env_vars
       #        Sets the EnvironmentVariables that will be defined at app launch
       #
       def environment_variables=(env_vars)
-        @xml_element.delete_element(XCScheme::VARIABLES_NODE)
+        delete_child_element(XCScheme::VARIABLES_NODE)
         @xml_element.add_element(env_vars.xml_element) if env_vars
         env_vars
       end
@@ -147,14 +147,14 @@ module Xcodeproj
       #         Returns the CommandLineArguments that will be passed at app launch
       #
       def command_line_arguments
-        CommandLineArguments.new(@xml_element.elements[XCScheme::COMMAND_LINE_ARGS_NODE])
+        CommandLineArguments.new(child_element(XCScheme::COMMAND_LINE_ARGS_NODE))
       end
 
       # @return [CommandLineArguments] arguments
       #         Sets the CommandLineArguments that will be passed at app launch
       #
       def command_line_arguments=(arguments)
-        @xml_element.delete_element(XCScheme::COMMAND_LINE_ARGS_NODE)
+        delete_child_element(XCScheme::COMMAND_LINE_ARGS_NODE)
         @xml_element.add_element(arguments.xml_element) if arguments
         arguments
       end
@@ -42,14 +42,14 @@ module Xcodeproj
       #         The BuildableProductRunnable to launch when launching the Profile action
       #
       def buildable_product_runnable
-        BuildableProductRunnable.new @xml_element.elements['BuildableProductRunnable'], 0
+        BuildableProductRunnable.new child_element('BuildableProductRunnable'), 0
       end
 
       # @param [BuildableProductRunnable] runnable
       #        Set the BuildableProductRunnable referencing the target to launch when profiling
       #
       def buildable_product_runnable=(runnable)
-        @xml_element.delete_element('BuildableProductRunnable')
+        delete_child_element('BuildableProductRunnable')
         @xml_element.add_element(runnable.xml_element) if runnable
       end
     end
@@ -60,14 +60,14 @@ module Xcodeproj
       #         The BuildableReference (Xcode target) associated with this ActionContent
       #
       def buildable_reference
-        BuildableReference.new(@xml_element.elements['EnvironmentBuildable'].elements['BuildableReference'])
+        BuildableReference.new(child_element('EnvironmentBuildable').elements['BuildableReference'])
       end
 
       # @param [BuildableReference] ref
       #        Set the BuildableReference (Xcode target) associated with this ActionContent
       #
       def buildable_reference=(ref)
-        @xml_element.delete_element('EnvironmentBuildable')
+        delete_child_element('EnvironmentBuildable')
 
         env_buildable = @xml_element.add_element('EnvironmentBuildable')
         env_buildable.add_element(ref.xml_element)
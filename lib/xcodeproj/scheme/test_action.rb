@@ -69,9 +69,9 @@ module Xcodeproj
       #         The list of TestableReference (test bundles) associated with this Test Action
       #
       def testables
-        return [] unless @xml_element.elements['Testables']
+        return [] unless child_element('Testables')
 
-        @xml_element.elements['Testables'].get_elements('TestableReference').map do |node|
+        child_element('Testables').get_elements('TestableReference').map do |node|
           TestableReference.new(node)
         end
       end
@@ -80,7 +80,7 @@ module Xcodeproj
       #         Sets the list of TestableReference (test bundles) associated with this Test Action
       #
       def testables=(testables)
-        @xml_element.delete_element('Testables')
+        delete_child_element('Testables')
         testables_element = @xml_element.add_element('Testables')
         testables.each do |testable|
           testables_element.add_element(testable.xml_element)
@@ -92,7 +92,7 @@ module Xcodeproj
       #        Add a TestableReference (test bundle) to this Test Action
       #
       def add_testable(testable)
-        testables = @xml_element.elements['Testables'] || @xml_element.add_element('Testables')
+        testables = child_element('Testables') || @xml_element.add_element('Testables')
         testables.add_element(testable.xml_element)
       end
 
@@ -109,7 +109,7 @@ module Xcodeproj
       #        Add a MacroExpansion to this TestAction
       #
       def add_macro_expansion(macro_expansion)
-        if testables = @xml_element.elements['Testables']
+        if testables = child_element('Testables')
           @xml_element.insert_before(testables, macro_expansion.xml_element)
         else
           @xml_element.add_element(macro_expansion.xml_element)
@@ -120,7 +120,7 @@ module Xcodeproj
       #         Returns the EnvironmentVariables that will be defined at test launch
       #
       def environment_variables
-        EnvironmentVariables.new(@xml_element.elements[XCScheme::VARIABLES_NODE])
+        EnvironmentVariables.new(child_element(XCScheme::VARIABLES_NODE))
       end
 
       # @param [EnvironmentVariables,nil] env_vars
@@ -128,7 +128,7 @@ module Xcodeproj
       # @return [EnvironmentVariables]
       #
       def environment_variables=(env_vars)
-        @xml_element.delete_element(XCScheme::VARIABLES_NODE)
+        delete_child_element(XCScheme::VARIABLES_NODE)
         @xml_element.add_element(env_vars.xml_element) if env_vars
         env_vars
       end
@@ -139,14 +139,14 @@ module Xcodeproj
       #         Returns the CommandLineArguments that will be passed at app launch
       #
       def command_line_arguments
-        CommandLineArguments.new(@xml_element.elements[XCScheme::COMMAND_LINE_ARGS_NODE])
+        CommandLineArguments.new(child_element(XCScheme::COMMAND_LINE_ARGS_NODE))
       end
 
       # @return [CommandLineArguments] arguments
       #         Sets the CommandLineArguments that will be passed at app launch
       #
       def command_line_arguments=(arguments)
-        @xml_element.delete_element(XCScheme::COMMAND_LINE_ARGS_NODE)
+        delete_child_element(XCScheme::COMMAND_LINE_ARGS_NODE)
         @xml_element.add_element(arguments.xml_element) if arguments
         arguments
       end
@@ -155,9 +155,9 @@ module Xcodeproj
       #         The list of BuildableReference (code coverage targets) associated with this Test Action
       #
       def code_coverage_targets
-        return [] unless @xml_element.elements['CodeCoverageTargets']
+        return [] unless child_element('CodeCoverageTargets')
 
-        @xml_element.elements['CodeCoverageTargets'].get_elements('BuildableReference').map do |node|
+        child_element('CodeCoverageTargets').get_elements('BuildableReference').map do |node|
           BuildableReference.new(node)
         end
       end
@@ -168,7 +168,7 @@ module Xcodeproj
       def code_coverage_targets=(buildable_references)
         @xml_element.attributes['onlyGenerateCoverageForSpecifiedTargets'] = bool_to_string(true)
 
-        @xml_element.delete_element('CodeCoverageTargets')
+        delete_child_element('CodeCoverageTargets')
         coverage_targets_element = @xml_element.add_element('CodeCoverageTargets')
         buildable_references.each do |reference|
           coverage_targets_element.add_element(reference.xml_element)
@@ -183,7 +183,7 @@ module Xcodeproj
       def add_code_coverage_target(buildable_reference)
         @xml_element.attributes['onlyGenerateCoverageForSpecifiedTargets'] = bool_to_string(true)
 
-        coverage_targets_element = @xml_element.elements['CodeCoverageTargets'] || @xml_element.add_element('CodeCoverageTargets')
+        coverage_targets_element = child_element('CodeCoverageTargets') || @xml_element.add_element('CodeCoverageTargets')
         coverage_targets_element.add_element(buildable_reference.xml_element)
 
         code_coverage_targets
@@ -284,8 +284,8 @@ module Xcodeproj
         #         The list of SkippedTest this action will skip.
         #
         def skipped_tests
-          return [] if @xml_element.elements['SkippedTests'].nil?
-          @xml_element.elements['SkippedTests'].get_elements('Test').map do |node|
+          return [] if child_element('SkippedTests').nil?
+          child_element('SkippedTests').get_elements('Test').map do |node|
             Test.new(node)
           end
         end
@@ -294,7 +294,7 @@ module Xcodeproj
         #         Set the list of SkippedTest this action will skip.
         #
         def skipped_tests=(tests)
-          @xml_element.delete_element('SkippedTests')
+          delete_child_element('SkippedTests')
           if tests.nil?
             return
           end
@@ -308,7 +308,7 @@ module Xcodeproj
         #         The SkippedTest to add to the list of tests this action will skip
         #
         def add_skipped_test(skipped_test)
-          entries = @xml_element.elements['SkippedTests'] || @xml_element.add_element('SkippedTests')
+          entries = child_element('SkippedTests') || @xml_element.add_element('SkippedTests')
           entries.add_element(skipped_test.xml_element)
         end
 
@@ -330,8 +330,8 @@ module Xcodeproj
         #         The list of SelectedTest this action will run.
         #
         def selected_tests
-          return [] if @xml_element.elements['SelectedTests'].nil?
-          @xml_element.elements['SelectedTests'].get_elements('Test').map do |node|
+          return [] if child_element('SelectedTests').nil?
+          child_element('SelectedTests').get_elements('Test').map do |node|
             Test.new(node)
           end
         end
@@ -340,7 +340,7 @@ module Xcodeproj
         #         Set the list of SelectedTest this action will run.
         #
         def selected_tests=(tests)
-          @xml_element.delete_element('SelectedTests')
+          delete_child_element('SelectedTests')
           return if tests.nil?
           entries = @xml_element.add_element('SelectedTests')
           tests.each do |selected|
@@ -352,7 +352,7 @@ module Xcodeproj
         #         The SelectedTest to add to the list of tests this action will run.
         #
         def add_selected_test(selected_test)
-          entries = @xml_element.elements['SelectedTests'] || @xml_element.add_element('SelectedTests')
+          entries = child_element('SelectedTests') || @xml_element.add_element('SelectedTests')
           entries.add_element(selected_test.xml_element)
         end
 
@@ -12,11 +12,8 @@ module Xcodeproj
       #         The XML representation of the node this XMLElementWrapper wraps,
       #         formatted in the same way that Xcode would.
       def to_s
-        formatter = XMLFormatter.new(2)
-        formatter.compact = false
-        out = ''
-        formatter.write(@xml_element, out)
-        out.gsub!("<?xml version='1.0' encoding='UTF-8'?>", '')
+        out = String.new
+        XMLSerializer.new(out).write_element(@xml_element)
         out << "\n"
         out
       end
@@ -54,6 +51,29 @@ module Xcodeproj
         end
       end
 
+      # @param [String] name
+      #        The name of the child element to look for
+      #
+      # @return [REXML::Element, Nil]
+      #         The first child element of the wrapped node with the given name,
+      #         looked up without the cost of an XPath query
+      #
+      def child_element(name)
+        @xml_element.each_element { |element| return element if element.name == name }
+        nil
+      end
+
+      # @param [String] name
+      #        The name of the child element to delete
+      #
+      # @return [REXML::Element, Nil]
+      #         The deleted child element, if any
+      #
+      def delete_child_element(name)
+        element = child_element(name)
+        @xml_element.delete_element(element) if element
+      end
+
       # @param [Bool]
       #        The boolean we want to represent as a string
       #
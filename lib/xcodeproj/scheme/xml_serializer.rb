@@ -0,0 +1,121 @@
+module Xcodeproj
+  class XCScheme
+    # Serializes the XML nodes of a scheme in the format of Xcode, with each
+    # attribute on its own line, directly to an IO or a String.
+    #
+    # The output is the same as the one of {XMLFormatter}, but the elements
+    # are written in a single pass without the indirections of the REXML
+    # formatters and without modifying the nodes.
+    #
+    class XMLSerializer
+      # @return [Integer] The indentation of each level of the elements.
+      #
+      INDENTATION = 3
+
+      # @return [String] The XML declaration as written by REXML.
+      #
+      REXML_XML_DECLARATION = "<?xml version='1.0' encoding='UTF-8'?>".freeze
+
+      # @return [String] The XML declaration as written by Xcode.
+      #
+      XCODE_XML_DECLARATION = '<?xml version="1.0" encoding="UTF-8"?>'.freeze
+
+      # @param  [#<<] output
+      #         The IO or the String which receives the XML.
+      #
+      def initialize(output)
+        @output = output
+      end
+
+      # Writes a document, with its XML declaration.
+      #
+      # @param  [REXML::Document] document
+      #         The document to write.
+      #
+      # @return [void]
+      #
+      def write_document(document)
+        quote = quote?(document)
+        children = document.children
+        children.each do |child|
+          next if child == children[-1] && child.instance_of?(REXML::Text)
+          unless child == children[0] || child.instance_of?(REXML::Text) || (child == children[1] && !children[0].writethis)
+            @output << "\n"
+          end
+          if child.is_a?(REXML::XMLDecl)
+            declaration = String.new
+            child.write(declaration)
+            @output << declaration.sub(REXML_XML_DECLARATION, XCODE_XML_DECLARATION)
+          else
+            write_node(child, 0, quote)
+          end
+        end
+      end
+
+      # Writes an element and its descendants.
+      #
+      # @param  [REXML::Element] element
+      #         The element to write.
+      #
+      # @return [void]
+      #
+      def write_element(element)
+        parent = element.parent
+        write_node(element, 0, quote?(parent || element))
+      end
+
+      private
+
+      # @!group Private helpers
+      #-----------------------------------------------------------------------#
+
+      # @return [Bool] Whether the attributes should be quoted with double
+      #         quotes, according to the context of the given node.
+      #
+      def quote?(node)
+        context = node.context
+        context && context[:attribute_quote] == :quote ? true : false
+      end
+
+      # Writes a node at the given indentation level.
+      #
+      # @return [void]
+      #
+      def write_node(node, level, quote)
+        unless node.is_a?(REXML::Element)
+          formatter = XMLFormatter.new(2)
+          formatter.compact = false
+          formatter.write_at_level(node, @output, level)
+          return
+        end
+
+        indentation = ' ' * level
+        name = node.expanded_name
+        @output << indentation << '<' << name
+        node.attributes.each_attribute do |attribute|
+          @output << "\n" << indentation << (' ' * INDENTATION) << attribute.expanded_name << ' = ' << quoted(attribute.to_s, quote)
+        end
+        @output << ">\n"
+        node.children.each do |child|
+          next if child.is_a?(REXML::Text) && child.to_s.strip.empty?
+          write_node(child, level + INDENTATION, quote)
+          @output << "\n"
+        end
+        @output << indentation << '</' << name << '>'
+      end
+
+      # @return [String] The given normalized attribute value quoted like
+      #         `REXML::Attribute#to_string`.
+      #
+      def quoted(value, quote)
+        if quote
+          value = value.gsub('"', '&quot;') if value.include?('"')
+          "\"#{value}\""
+        else
+          value = value.gsub("'", '&apos;') if value.include?("'")
+          "'#{value}'"
+        end
+      end
+    end
+  end
+end
@@ -2,6 +2,7 @@ require 'fileutils'
 require 'rexml/document'
 require 'xcodeproj/workspace/file_reference'
 require 'xcodeproj/workspace/group_reference'
+require 'xcodeproj/workspace/index'
 
 module Xcodeproj
   # Provides support for generating, reading and serializing Xcode Workspace
@@ -15,6 +16,11 @@ module Xcodeproj
     #         containing the scheme
     attr_reader :schemes
 
+    # @return [String] the path of the `xcworkspace` document, if the
+    #         workspace has been read from disk.
+    #
+    attr_accessor :path
+
     # @return [Array<FileReference>] the paths of the projects contained in the
     #         workspace.
     #
@@ -82,6 +88,7 @@ module Xcodeproj
     def self.from_s(xml, workspace_path = '')
       document = REXML::Document.new(xml)
       instance = new(document)
+      instance.path = workspace_path unless workspace_path.empty?
       instance.load_schemes(workspace_path)
       instance
     end
@@ -145,6 +152,23 @@ module Xcodeproj
       file_references.include?(file_reference)
     end
 
+    # Returns the index of the targets, the products and the schemes of the
+    # projects of the workspace. The index is persisted in the workspace and
+    # the projects which changed since the last call are read again.
+    #
+    # @example
+    #
+    #   workspace = Workspace.new_from_xcworkspace('App.xcworkspace')
+    #   workspace.index.project_for_target('Pods-App') # => "/path/to/Pods/Pods.xcodeproj"
+    #
+    # @return [Index] the index of the workspace.
+    #
+    def index
+      @index = Index.new(self, path) unless @index && @index.path == (path && File.expand_path(path))
+      @index.update
+      @index
+    end
+
     # @return [String] the XML representation of the workspace.
     #
     def to_s
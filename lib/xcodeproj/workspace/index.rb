@@ -0,0 +1,261 @@
+require 'etc'
+require 'fileutils'
+require 'json'
+
+module Xcodeproj
+  class Workspace
+    # Indexes the targets, the products and the schemes of the projects of a
+    # workspace, so that the project which defines any of them can be found
+    # without opening all the projects.
+    #
+    # The targets of the projects are read from their `project.pbxproj` file
+    # without initializing a {Project}, in parallel, and the index is
+    # persisted in the `xcuserdata` folder of the workspace. The entry of a
+    # project is read again only if its `project.pbxproj` file or the folder
+    # of its shared schemes changed.
+    #
+    # @note   If several projects define the same target, product or scheme
+    #         the last one of the workspace wins, as in {Workspace#schemes}.
+    #
+    class Index
+      # @return [String] The name of the file where the index is persisted,
+      #         in the `xcuserdata` folder of the workspace.
+      #
+      FILE_NAME = 'xcodeproj_index.json'.freeze
+
+      # @return [Array<String>] The ISAs of the targets.
+      #
+      TARGET_ISAS = %w(PBXNativeTarget PBXAggregateTarget PBXLegacyTarget).freeze
+
+      # @return [Workspace] the indexed workspace.
+      #
+      attr_reader :workspace
+
+      # @return [String] the path of the `xcworkspace` document, if any.
+      #
+      attr_reader :path
+
+      # @param  [Workspace] workspace
+      #         the workspace to index.
+      #
+      # @param  [String, Nil] path
+      #         the path of the `xcworkspace` document, which is used to
+      #         resolve the paths of the projects and to persist the index.
+      #
+      def initialize(workspace, path = nil)
+        @workspace = workspace
+        @path = path && !path.to_s.empty? ? File.expand_path(path.to_s) : nil
+        @entries = read
+      end
+
+      # @!group Queries
+      #-----------------------------------------------------------------------#
+
+      # @param  [String] name
+      #         the name of the target.
+      #
+      # @return [String] the path of the project which defines the target.
+      # @return [Nil] if no project defines the target.
+      #
+      def project_for_target(name)
+        @projects_by_target[name]
+      end
+
+      # @param  [String] uuid
+      #         the UUID of the target.
+      #
+      # @return [String] the path of the project which defines the target.
+      # @return [Nil] if no project defines the target.
+      #
+      def project_for_target_uuid(uuid)
+        @projects_by_target_uuid[uuid]
+      end
+
+      # @param  [String] name
+      #         the product name of a target (e.g. `App`) or the name of its
+      #         product (e.g. `App.app`).
+      #
+      # @return [String] the path of the project which defines the product.
+      # @return [Nil] if no project defines the product.
+      #
+      def project_for_product(name)
+        @projects_by_product[name]
+      end
+
+      # @param  [String] name
+      #         the name of the scheme.
+      #
+      # @return [String] the path of the project, or of the workspace, which
+      #         contains the scheme, as {Workspace#schemes}.
+      # @return [Nil] if no project contains the scheme.
+      #
+      def project_for_scheme(name)
+        @projects_by_scheme[name]
+      end
+
+      # @return [Array<String>] the paths of the indexed projects, in the
+      #         order of the workspace.
+      #
+      def project_paths
+        @project_paths.dup
+      end
+
+      # @!group Updating
+      #-----------------------------------------------------------------------#
+
+      # Reads again the projects which changed since they were indexed and
+      # persists the index if any of them did.
+      #
+      # @return [void]
+      #
+      def update
+        @project_paths = workspace.file_references.map do |file_reference|
+          file_reference.absolute_path(workspace_dir)
+        end.uniq
+
+        stamps = Hash[@project_paths.map { |project_path| [project_path, stamp(project_path)] }]
+        stale = @project_paths.reject { |project_path| (entry = @entries[project_path]) && entry['stamp'] == stamps[project_path] }
+        removed = @entries.keys - @project_paths
+        removed.each { |project_path| @entries.delete(project_path) }
+
+        read_projects(stale).each do |project_path, entry|
+          @entries[project_path] = entry.merge('stamp' => stamps[project_path])
+        end
+        write unless stale.empty? && removed.empty?
+
+        build_lookups
+      end
+
+      private
+
+      # @!group Private helpers
+      #-----------------------------------------------------------------------#
+
+      # @return [String] the directory which contains the workspace, used to
+      #         resolve the paths of the projects.
+      #
+      def workspace_dir
+        path ? File.dirname(path) : Dir.pwd
+      end
+
+      # @return [String] the path of the file where the index is persisted.
+      #
+      def index_path
+        File.join(path, 'xcuserdata', FILE_NAME) if path
+      end
+
+      # @return [Array] the stamp of the files a project entry depends on.
+      #
+      def stamp(project_path)
+        [File.join(project_path, 'project.pbxproj'), File.join(project_path, 'xcshareddata', 'xcschemes')].map do |file|
+          begin
+            stat = File.stat(file)
+            [stat.mtime.to_i, stat.mtime.nsec, stat.size]
+          rescue SystemCallError
+            nil
+          end
+        end
+      end
+
+      # Reads the targets and the schemes of the given projects with a
+      # thread per processor.
+      #
+      # @return [Hash{String => Hash}] the entries of the projects.
+      #
+      def read_projects(project_paths)
+        queue = Queue.new
+        project_paths.each { |project_path| queue << project_path }
+        workers = Array.new([project_paths.size, Etc.nprocessors].min) do
+          Thread.new do
+            entries = {}
+            until queue.empty?
+              project_path = begin
+                               queue.pop(true)
+                             rescue ThreadError
+                               break
+                             end
+              entries[project_path] = read_project(project_path)
+            end
+            entries
+          end
+        end
+        workers.map(&:value).reduce({}, :merge)
+      end
+
+      # @return [Hash] the entry of the given project.
+      #
+      def read_project(project_path)
+        pbxproj_path = File.join(project_path, 'project.pbxproj')
+        targets = []
+        if File.exist?(pbxproj_path)
+          objects = Plist.read_from_path(pbxproj_path)['objects'] || {}
+          objects.each do |uuid, attributes|
+            next unless TARGET_ISAS.include?(attributes['isa'])
+            product_reference = objects[attributes['productReference']]
+            targets << {
+              'name' => attributes['name'],
+              'uuid' => uuid,
+              'product_name' => attributes['productName'],
+              'product' => product_reference && product_reference['path'],
+            }
+          end
+        end
+        { 'targets' => targets, 'schemes' => Project.schemes(project_path) }
+      end
+
+      # @return [Hash{String => Hash}] the entries persisted for the current
+      #         version of Xcodeproj, if any.
+      #
+      def read
+        return {} unless index_path && File.exist?(index_path)
+        contents = JSON.parse(File.read(index_path))
+        return {} unless contents['version'] == VERSION
+        contents['projects'] || {}
+      rescue JSON::ParserError, SystemCallError
+        {}
+      end
+
+      # Persists the index. The index is only a cache, so the errors are
+      # ignored.
+      #
+      # @return [void]
+      #
+      def write
+        return unless index_path && File.directory?(path)
+        FileUtils.mkdir_p(File.dirname(index_path))
+        temporary_path = "#{index_path}.#{Process.pid}"
+        File.write(temporary_path, JSON.generate('version' => VERSION, 'projects' => @entries))
+        File.rename(temporary_path, index_path)
+      rescue SystemCallError
+        nil
+      end
+
+      # Builds the hashes which answer the queries from the entries of the
+      # projects.
+      #
+      # @return [void]
+      #
+      def build_lookups
+        @projects_by_target = {}
+        @projects_by_target_uuid = {}
+        @projects_by_product = {}
+        @projects_by_scheme = {}
+        @project_paths.each do |project_path|
+          entry = @entries[project_path]
+          entry['targets'].each do |target|
+            @projects_by_target[target['name']] = project_path
+            @projects_by_target_uuid[target['uuid']] = project_path
+            @projects_by_product[target['product_name']] = project_path if target['product_name']
+            @projects_by_product[target['product']] = project_path if target['product']
+          end
+          entry['schemes'].each { |scheme| @projects_by_scheme[scheme] = project_path }
+        end
+
+        return unless path
+        Dir[File.join(path, 'xcshareddata', 'xcschemes', '*.xcscheme')].each do |scheme|
+          @projects_by_scheme[File.basename(scheme, '.xcscheme')] = path
+        end
+      end
+    end
+  end
+end
@@ -0,0 +1,48 @@
+require File.expand_path('../../spec_helper', __FILE__)
+
+describe Xcodeproj::Config::FileCache do
+  extend SpecHelper::TemporaryDirectory
+
+  before do
+    Xcodeproj::Config.clear_cache
+    @path = temporary_directory + 'Base.xcconfig'
+    @include_path = temporary_directory + 'Included.xcconfig'
+    File.write(@include_path, "INCLUDED = YES\n")
+    File.write(@path, "#include \"Included\"\nBASE = YES\n")
+  end
+
+  it 'parses each configuration file only once' do
+    3.times { Xcodeproj::Config.new(@path).to_hash.should == { 'INCLUDED' => 'YES', 'BASE' => 'YES' } }
+    Xcodeproj::Config.cache_statistics[:misses].should == 2
+    Xcodeproj::Config.cache_statistics[:hits].should > 0
+  end
+
+  it 'parses a configuration file again once it changes' do
+    Xcodeproj::Config.new(@path).to_hash['BASE'].should == 'YES'
+    File.write(@path, "#include \"Included\"\nBASE = CHANGED\n")
+    Xcodeproj::Config.new(@path).to_hash['BASE'].should == 'CHANGED'
+  end
+
+  it 'resolves the includes again once an included file changes' do
+    Xcodeproj::Config.new(@path).to_hash['INCLUDED'].should == 'YES'
+    File.write(@include_path, "INCLUDED = CHANGED\n")
+    Xcodeproj::Config.new(@path).to_hash['INCLUDED'].should == 'CHANGED'
+    File.delete(@include_path)
+    Xcodeproj::Config.new(@path).to_hash.should == { 'BASE' => 'YES' }
+  end
+
+  it 'is not affected by the modifications of the configurations' do
+    config = Xcodeproj::Config.new(@path)
+    config.attributes['BASE'] << 'NO'
+    config.includes << 'Other.xcconfig'
+    other = Xcodeproj::Config.new(@path)
+    other.attributes.should == { 'BASE' => 'YES' }
+    other.includes.should == ['Included.xcconfig']
+  end
+
+  it 'discards the entries of the saved configuration files' do
+    Xcodeproj::Config.new(@path)
+    Xcodeproj::Config.new('BASE' => 'NO').save_as(@path)
+    Xcodeproj::Config.new(@path).to_hash.should == { 'BASE' => 'NO' }
+  end
+end
@@ -188,6 +188,22 @@ Y = 123
       }
     end
 
+    it 'splits the values of a setting only once when merging' do
+      @config.merge!('HEADER_SEARCH_PATHS' => '/some/path')
+      @config.merge!('HEADER_SEARCH_PATHS' => '"/some/other path"')
+      Shellwords.expects(:split).with('/some/path/subdir').returns(['/some/path/subdir'])
+      @config.merge!('HEADER_SEARCH_PATHS' => '/some/path/subdir')
+      @config.merge(@config).to_hash['HEADER_SEARCH_PATHS'].should == '/some/path "/some/other path" /some/path/subdir'
+    end
+
+    it 'does not reuse the tokens of a value which has been modified' do
+      @config.merge!('FOO' => 'a')
+      @config.merge!('FOO' => 'b')
+      @config.attributes['FOO'] << ' c'
+      @config.merge!('FOO' => 'c')
+      @config.to_hash['FOO'].should == 'a b c'
+    end
+
     it 'generates the config file with refs to all included xcconfigs' do
       @config.includes = ['Somefile.xcconfig']
       @config.to_s.split("\n").first.should == '#include "Somefile.xcconfig"'
@@ -205,6 +205,28 @@ module Xcodeproj
           },
         }
       end
+
+      it 'diffs the objects of two projects like their tree hashes' do
+        project_1 = Project.open(fixture_path('Sample Project/Cocoa Application.xcodeproj'))
+        project_2 = Project.open(fixture_path('Sample Project/Cocoa Application.xcodeproj'))
+        project_2.main_group.files.first.path = 'new_path/file_1.m'
+        project_2.main_group.new_file('file_2.m')
+        project_2.targets.first.build_configurations.first.build_settings['FOO'] = 'BAR'
+        project_2.targets.last.frameworks_build_phase.files.first.remove_from_project
+
+        Differ.project_diff(project_1, project_1).should.be.nil
+        [[], %w(path), %w(displayName isa)].each do |ignored_keys|
+          expected = Differ.project_diff(project_1.to_tree_hash, project_2.to_tree_hash, 'p1', 'p2', ignored_keys)
+          Differ.project_diff(project_1, project_2, 'p1', 'p2', ignored_keys).should == expected
+        end
+      end
+
+      it 'diffs two different projects like their tree hashes' do
+        project_1 = Project.open(fixture_path('Sample Project/Cocoa Application.xcodeproj'))
+        project_2 = Project.open(fixture_path('Sample Project/ContainsSubproject/ContainsSubproject.xcodeproj'))
+        expected = Differ.project_diff(project_1.to_tree_hash, project_2.to_tree_hash)
+        Differ.project_diff(project_1, project_2).should == expected
+      end
     end
 
     #-------------------------------------------------------------------------#
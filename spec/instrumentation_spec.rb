@@ -0,0 +1,85 @@
+require File.expand_path('../spec_helper', __FILE__)
+
+module Xcodeproj
+  describe Instrumentation do
+    extend SpecHelper::TemporaryDirectory
+
+    before do
+      @project_path = fixture_path('Sample Project/Cocoa Application.xcodeproj')
+      @events = []
+      @subscriber = Instrumentation.subscribe { |event| @events << event }
+    end
+
+    after do
+      Instrumentation.unsubscribe(@subscriber)
+    end
+
+    it 'publishes the phases of opening, sorting and saving a project' do
+      project = Project.open(@project_path)
+      project.sort
+      project.save(temporary_directory + 'Project.xcodeproj')
+      @events.map(&:name).should == %w(
+        project.open.parse project.open.objects project.open.fixups project.open
+        project.sort
+        project.save.serialize project.save.write project.save
+      )
+      @events.each do |event|
+        event.subject.should.equal project
+        event.duration.should >= 0
+        event.allocations.should >= 0
+      end
+      @events.map(&:object_counts).uniq.should == [nil]
+    end
+
+    it 'counts the objects of the project at the end of each phase if asked to' do
+      events = []
+      subscriber = Instrumentation.subscribe(/^project\.open/, :object_counts => true) { |event| events << event }
+      project = Project.open(@project_path)
+      project.new_target(:static_library, 'Library', :ios)
+      project.save(temporary_directory + 'Project.xcodeproj')
+      Instrumentation.unsubscribe(subscriber)
+      counts = Hash[events.map { |event| [event.name, event.object_counts] }]
+      counts['project.open.parse'].should.be.empty
+      counts['project.open']['PBXNativeTarget'].should == project.native_targets.count - 1
+      @events.map(&:name).last.should == 'project.save'
+      @events.last.object_counts.should.be.nil
+    end
+
+    it 'only publishes the events matching the pattern of a subscriber' do
+      names = []
+      subscriber = Instrumentation.subscribe(/^project\.open\./) { |event| names << event.name }
+      Project.open(@project_path)
+      Instrumentation.unsubscribe(subscriber)
+      names.should == %w(project.open.parse project.open.objects project.open.fixups)
+    end
+
+    it 'does not measure the phases without subscribers' do
+      Instrumentation.unsubscribe(@subscriber)
+      Instrumentation.subscribed?.should.be.false
+      Process.expects(:clock_gettime).never
+      Project.open(@project_path).save(temporary_directory + 'Project.xcodeproj')
+      @events.should.be.empty
+    end
+
+    describe Instrumentation::Profiler do
+      it 'summarizes the phases under their operation' do
+        Instrumentation.unsubscribe(@subscriber)
+        profiler = Instrumentation::Profiler.new
+        profiler.start
+        Project.open(@project_path).predictabilize_uuids
+        profiler.stop
+        Instrumentation.subscribed?.should.be.false
+
+        profiler.phases['project.open'][:count].should == 1
+        lines = profiler.report.lines.map(&:rstrip)
+        labels = lines[1, 8].map { |line| line.split(/\s{2,}(?=\d)/).first }
+        labels.should == [
+          'project.open', '  parse', '  objects', '  fixups',
+          'project.predictabilize_uuids', '  paths', '  switch', '  fixups',
+        ]
+        lines.should.include 'Objects at the end of project.predictabilize_uuids'
+        lines.grep(/^PBXProject\s+1$/).count.should == 1
+      end
+    end
+  end
+end
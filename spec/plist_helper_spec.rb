@@ -181,6 +181,19 @@ EOS
           Plist.read_from_path(@plist)
         end.should.not.raise
       end
+
+      it 'detects the conflict markers only in order' do
+        Plist.file_in_conflict?("<<<<<<< HEAD\na\n=======\nb\n>>>>>>> branch\n").should.be.true
+        Plist.file_in_conflict?(">>>>>>> branch\n=======\n<<<<<<< HEAD\n").should.be.false
+        Plist.file_in_conflict?("<<<<<<< HEAD\n" + "a\n=======\n" * 1000).should.be.false
+      end
+
+      it 'reads the contents of a plist file into a frozen buffer' do
+        Plist.write_to_path({ 'archiveVersion' => '1.0' }, @plist)
+        contents = Plist.read_contents(@plist)
+        contents.should.be.frozen
+        Plist.read_from_contents(contents, @plist).should == { 'archiveVersion' => '1.0' }
+      end
     end
   end
 end
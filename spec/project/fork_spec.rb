@@ -0,0 +1,117 @@
+require File.expand_path('../../spec_helper', __FILE__)
+
+module ProjectSpecs
+  describe 'Xcodeproj::Project#fork' do
+    before do
+      @group = @project.main_group.new_group('Classes', 'Classes')
+      @file = @group.new_file('Foo.m')
+      @target = @project.new_target(:static_library, 'Library', :ios)
+      @target.add_file_references([@file])
+      @project.save(@project.path)
+    end
+
+    def deep_copy(object)
+      Marshal.load(Marshal.dump(object))
+    end
+
+    it 'initializes the objects of the fork on demand' do
+      fork = @project.fork
+      fork.should.be.lazily_loaded
+      fork.loaded_objects_by_uuid.keys.should == [@project.root_object.uuid]
+      fork.root_object.should.not.equal?(@project.root_object)
+      fork.should.not.be.dirty
+      fork.to_hash.should == @project.to_hash
+      fork.verify_object_index!
+    end
+
+    it 'keeps the objects of the project and of the fork independent' do
+      state = deep_copy(@project.to_hash)
+      fork = @project.fork
+      fork_file = fork.main_group['Classes'].files.first
+      fork_file.path = 'Bar.m'
+      fork.targets.first.build_configurations.first.build_settings['OTHER_LDFLAGS'] = '-ObjC'
+      @project.to_hash.should == state
+
+      @file.path = 'Baz.m'
+      @target.build_configurations.first.build_settings['CLANG_ENABLE_MODULES'] = 'NO'
+      @project.root_object.attributes['ORGANIZATIONNAME'] = 'Org'
+      @group.children.clear
+      fork_file.real_path.should == fork.project_dir + 'Classes/Bar.m'
+      fork_settings = fork.targets.first.build_configurations.map(&:build_settings)
+      fork_settings.first['OTHER_LDFLAGS'].should == '-ObjC'
+      fork_settings.map { |settings| settings['CLANG_ENABLE_MODULES'] }.should.not.include 'NO'
+      fork.root_object.attributes.should.not.key 'ORGANIZATIONNAME'
+      fork.main_group['Classes'].files.should == [fork_file]
+      fork.targets.first.source_build_phase.files_references.should == [fork_file]
+      fork.verify_object_index!
+    end
+
+    it 'initializes each fork from the objects as they were when it has been forked' do
+      configuration = @target.build_configurations.first
+      first = @project.fork
+      @file.path = 'Bar.m'
+      configuration.build_settings['VARIANT'] = 'Bar'
+      second = @project.fork
+      third = @project.fork
+      @file.path = 'Baz.m'
+      configuration.build_settings['VARIANT'] = 'Baz'
+
+      forks = [first, second, third]
+      forks.map { |fork| fork.main_group['Classes'].files.first.path }.should == %w(Foo.m Bar.m Bar.m)
+      forks.map { |fork| fork.targets.first.build_configurations.first.build_settings['VARIANT'] }.should == [nil, 'Bar', 'Bar']
+      @file.path.should == 'Baz.m'
+    end
+
+    it 'shares the recorded objects between the forks' do
+      second, third = Array.new(2) { @project.fork }
+      @file.path = 'Bar.m'
+      paths = [second, third].map { |fork| fork.main_group['Classes'].files.first.path }
+      paths.should == %w(Foo.m Foo.m)
+      paths.first.should.be.frozen
+      paths.first.should.equal?(paths.last)
+      second.targets.first.build_configurations.first.build_settings['VARIANT'] = 'Second'
+      third.targets.first.build_configurations.first.build_settings.should.not.key 'VARIANT'
+    end
+
+    it 'keeps the UUIDs of the fork if the UUIDs of the project change' do
+      fork = @project.fork
+      uuids = @project.uuids.sort
+      @project.predictabilize_uuids
+      fork.uuids.sort.should == uuids
+    end
+
+    it 'saves the fork independently' do
+      contents = File.read(@project.path + 'project.pbxproj')
+      fork = @project.fork
+      @file.path = 'Bar.m'
+      fork.save(@project.path.dirname + 'Fork.xcodeproj')
+      File.read(@project.path.dirname + 'Fork.xcodeproj/project.pbxproj').should == contents
+      File.read(@project.path + 'project.pbxproj').should == contents
+    end
+
+    it 'forks a lazily opened project without initializing its objects' do
+      project = Xcodeproj::Project.open(@project.path, :lazy => true)
+      loaded = project.loaded_objects_by_uuid.count
+      fork = project.fork
+      project.should.be.lazily_loaded
+      project.loaded_objects_by_uuid.count.should == loaded
+
+      project.targets.first.build_configurations.first.build_settings['VARIANT'] = 'Project'
+      project.main_group['Classes'].files.first.path = 'Bar.m'
+      fork.to_hash.should == @project.to_hash
+      fork.verify_object_index!
+    end
+
+    it 'forks a fork without initializing its objects' do
+      fork = @project.fork.fork
+      fork.should.be.lazily_loaded
+      fork.to_hash.should == @project.to_hash
+    end
+
+    it 'raises during a transaction' do
+      should.raise do
+        @project.transaction { @project.fork }
+      end.message.should.match /cannot be forked during a transaction/
+    end
+  end
+end
@@ -29,6 +29,40 @@ module ProjectSpecs
 
     #-------------------------------------------------------------------------#
 
+    describe '::new_references' do
+      it 'adds the references to the subgroups matching their directories' do
+        existing = @group.new_group('Models', 'Models')
+        refs = @factory.new_references(@group, ['Models/User.m', 'Views/Cell/Cell.xib', 'Main.swift'])
+        refs.map(&:path).should == %w(User.m Cell.xib Main.swift)
+        refs.map { |ref| ref.parent.display_name }.should == %w(Models Cell Classes)
+        refs.first.parent.should.equal?(existing)
+        refs.map(&:last_known_file_type).should == %w(sourcecode.c.objc file.xib sourcecode.swift)
+        refs.map(&:real_path).should == [
+          @project.project_dir + 'Models/User.m',
+          @project.project_dir + 'Views/Cell/Cell.xib',
+          @project.project_dir + 'Main.swift',
+        ]
+        @group.groups.map(&:path).should == %w(Models Views)
+      end
+
+      it 'returns the existing references instead of duplicating them' do
+        ref = @group.new_reference('File.m')
+        refs = @factory.new_references(@group, ['File.m', @project.project_dir + 'File.m', 'Frameworks/Awesome.framework'])
+        refs[0].should.equal?(ref)
+        refs[1].should.equal?(ref)
+        refs[2].include_in_index.should.be.nil
+        @group.files.should == [ref]
+      end
+
+      it 'adds the references outside of the group to the group' do
+        ref = @factory.new_references(@group, ['../Outside.m']).first
+        ref.parent.should == @group
+        ref.real_path.should == @project.project_dir.dirname + 'Outside.m'
+      end
+    end
+
+    #-------------------------------------------------------------------------#
+
     describe '::new_static_library' do
       before do
         @ref = @factory.new_product_ref_for_target(@group, 'Pods', :static_library)
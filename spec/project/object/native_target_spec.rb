@@ -271,6 +271,63 @@ module ProjectSpecs
 
       #----------------------------------------#
 
+      describe '#resolved_build_settings' do
+        before do
+          project_xcconfig = @project.new_file(fixture_path('project.xcconfig'))
+          @project.build_configuration_list.build_configurations.each { |build_config| build_config.base_configuration_reference = project_xcconfig }
+          target_xcconfig = @project.new_file(fixture_path('target.xcconfig'))
+          @target.build_configuration_list.build_configurations.each { |build_config| build_config.base_configuration_reference = target_xcconfig }
+          @project.build_configuration_list.set_setting('PROJECT_USER_DEFINED', 'PROJECT_USER_DEFINED_VALUE')
+          @target.build_configuration_list.set_setting('TARGET_USER_DEFINED', '$(PROJECT_USER_DEFINED) $(CONFIGURATION)')
+          @target.build_configuration_list.set_setting('OTHER_LDFLAGS', %w(${inherited} -framework CoreData))
+        end
+
+        it 'returns the same values as the resolution of each build setting' do
+          %w(Debug Release).each do |name|
+            settings = @target.resolved_build_settings(name)
+            settings['TARGET_USER_DEFINED'].should == "PROJECT_USER_DEFINED_VALUE #{name}"
+            keys = @target.build_configuration_list[name].build_setting_keys | @project.build_configuration_list[name].build_setting_keys
+            expected = {}
+            keys.each do |key|
+              value = @target.resolved_build_setting(key, true)[name]
+              expected[key] = value unless value.nil?
+            end
+            settings.should == expected
+          end
+        end
+
+        it 'returns the new values once the build settings change' do
+          @target.resolved_build_settings('Debug')['TARGET_USER_DEFINED'].should == 'PROJECT_USER_DEFINED_VALUE Debug'
+          @project.build_configuration_list['Debug'].build_settings['PROJECT_USER_DEFINED'] = 'CHANGED'
+          @target.resolved_build_settings('Debug')['TARGET_USER_DEFINED'].should == 'CHANGED Debug'
+          @target.build_configuration_list['Debug'].build_settings.delete('TARGET_USER_DEFINED')
+          @target.resolved_build_settings('Debug').key?('TARGET_USER_DEFINED').should.be.false
+        end
+
+        it 'returns the new values once the environment variables they reference change' do
+          @target.build_configuration_list.set_setting('TARGET_ENVIRONMENT', '$(XCODEPROJ_SPEC_ENVIRONMENT)')
+          begin
+            ENV['XCODEPROJ_SPEC_ENVIRONMENT'] = 'VALUE'
+            @target.resolved_build_settings('Debug')['TARGET_ENVIRONMENT'].should == 'VALUE'
+            ENV['XCODEPROJ_SPEC_ENVIRONMENT'] = 'CHANGED'
+            @target.resolved_build_settings('Debug')['TARGET_ENVIRONMENT'].should == 'CHANGED'
+          ensure
+            ENV.delete('XCODEPROJ_SPEC_ENVIRONMENT')
+          end
+        end
+
+        it 'breaks the cycles between build settings' do
+          @target.build_configuration_list.set_setting('CYCLE_A', '$(CYCLE_B)')
+          @target.build_configuration_list.set_setting('CYCLE_B', '$(CYCLE_C)')
+          @target.build_configuration_list.set_setting('CYCLE_C', '$(CYCLE_A)')
+          settings = @target.resolved_build_settings('Debug')
+          settings.key?('CYCLE_A').should.be.false
+          @target.resolved_build_setting('CYCLE_A', true).should == { 'Release' => nil, 'Debug' => nil }
+        end
+      end
+
+      #----------------------------------------#
+
       it 'returns the SDK specified in its build configuration' do
         @project.build_configuration_list.set_setting('SDKROOT', nil)
         @target.build_configuration_list.set_setting('SDKROOT', 'iphoneos')
@@ -1042,6 +1099,43 @@ module ProjectSpecs
         build_files = @target.resources_build_phase.files
         build_files.count.should == 1
       end
+
+      it 'adds files in bulk to the build phases matching their extensions' do
+        group = @project.main_group.new_group('Sources', 'Sources')
+        refs = @target.add_files(%w(Class.m Class.h Image.png Model/Model.swift), :group => group, :compiler_flags => '-fobjc-arc')
+        refs.map(&:path).should == %w(Class.m Class.h Image.png Model.swift)
+        @target.source_build_phase.files.map { |build_file| [build_file.display_name, build_file.settings] }.should == [
+          ['Class.m', { 'COMPILER_FLAGS' => '-fobjc-arc' }],
+          ['Model.swift', { 'COMPILER_FLAGS' => '-fobjc-arc' }],
+        ]
+        @target.headers_build_phase.files_references.should == [refs[1]]
+        @target.resources_build_phase.files_references.should == [refs[2]]
+        refs.last.parent.hierarchy_path.should == '/Sources/Model'
+      end
+
+      it 'adds the libraries and frameworks added in bulk to the frameworks build phase' do
+        refs = @target.add_files(%w(libFoo.a libBar.tbd Foo.framework Bar.xcframework))
+        @target.frameworks_build_phase.files_references.should == refs
+        @target.source_build_phase.files.should.be.empty
+      end
+
+      it 'only adds the configuration and metadata files added in bulk to the group' do
+        paths = %w(Info.plist Config.xcconfig App.entitlements module.modulemap README.md LICENSE notes.txt)
+        refs = @target.add_files(paths)
+        refs.map(&:path).should == paths
+        @project.main_group.files.should == refs
+        @target.build_phases.map(&:files).flatten.should.be.empty
+      end
+
+      it 'de-duplicates files added in bulk' do
+        ref = @project.main_group.new_file('Class.m')
+        @target.add_file_references([ref])
+        @target.add_files(%w(Class.m Class.m Image.png))
+        @target.add_files(%w(Image.png)).should == [@project.main_group.files.last]
+        @project.main_group.files.map(&:path).should == %w(Class.m Image.png)
+        @target.source_build_phase.files_references.should == [ref]
+        @target.resources_build_phase.files.count.should == 1
+      end
     end
   end
 
@@ -0,0 +1,125 @@
+require File.expand_path('../../spec_helper', __FILE__)
+
+module ProjectSpecs
+  describe Xcodeproj::Project::ObjectIndex do
+    describe 'In general' do
+      before do
+        @group = @project.main_group.new_group('Classes', 'Classes')
+        @file = @group.new_file('Foo.m')
+      end
+
+      it 'indexes the objects by class' do
+        @project.list_by_class(PBXGroup).should.include?(@group)
+        @project.files.should.include?(@file)
+        @project.verify_object_index!
+      end
+
+      it 'removes the objects which are removed from the project' do
+        @file.remove_from_project
+        @project.files.should.not.include?(@file)
+        @project.verify_object_index!
+      end
+
+      it 'removes the objects which become unreachable' do
+        @project.main_group.children.delete(@group)
+        @project.list_by_class(PBXGroup).should.not.include?(@group)
+        @project.verify_object_index!
+      end
+
+      it 'finds the file references of a group by path' do
+        @group.find_file_by_path('Foo.m').should == @file
+        @file.path = 'Bar.m'
+        @group.find_file_by_path('Foo.m').should.be.nil
+        @group.find_file_by_path('Bar.m').should == @file
+        @project.main_group.find_file_by_path('Bar.m').should.be.nil
+        @project.verify_object_index!
+      end
+
+      it 'finds the file references by real path' do
+        real_path = @project.project_dir + 'Classes/Foo.m'
+        @project.reference_for_path(real_path).should == @file
+        @file.path = 'Bar.m'
+        @project.reference_for_path(real_path).should.be.nil
+        @project.reference_for_path(@project.project_dir + 'Classes/Bar.m').should == @file
+        @project.verify_object_index!
+      end
+
+      it 'updates the real paths when a group changes' do
+        @project.reference_for_path(@project.project_dir + 'Classes/Foo.m').should == @file
+        @group.path = 'Sources'
+        @project.reference_for_path(@project.project_dir + 'Sources/Foo.m').should == @file
+        other_group = @project.main_group.new_group('Other', 'Other')
+        @file.move(other_group)
+        @project.reference_for_path(@project.project_dir + 'Other/Foo.m').should == @file
+        @project.verify_object_index!
+      end
+
+      it 'only recomputes the real paths of the subtree of a modified group' do
+        other_file = @project.main_group.new_group('Other', 'Other').new_file('Bar.m')
+        @project.reference_for_path(@project.project_dir + 'Classes/Foo.m').should == @file
+        other_file.expects(:real_path).never
+        @group.path = 'Sources'
+        @project.main_group.new_group('Empty', 'Empty')
+        @project.reference_for_path(@project.project_dir + 'Sources/Foo.m').should == @file
+      end
+
+      it 'indexes the file references added after a query' do
+        @project.reference_for_path(@project.project_dir + 'Classes/Foo.m')
+        file = @group.new_file('Baz.m')
+        @project.reference_for_path(@project.project_dir + 'Classes/Baz.m').should == file
+        @project.verify_object_index!
+      end
+
+      it 'caches the paths until a parent of the object changes' do
+        subgroup = @group.new_group('Sub', 'Sub')
+        file = subgroup.new_file('Baz.m')
+        file.real_path.should.equal file.real_path
+        file.hierarchy_path.should == '/Classes/Sub/Baz.m'
+
+        @group.path = 'Sources'
+        file.real_path.should == @project.project_dir + 'Sources/Sub/Baz.m'
+        @group.name = 'Renamed'
+        file.hierarchy_path.should == '/Renamed/Sub/Baz.m'
+        @group.set_source_tree(:absolute)
+        file.full_path.should == Pathname('/Sources/Sub/Baz.m')
+
+        subgroup.move(@project.main_group)
+        file.parents.should == [@project.main_group, subgroup]
+        file.real_path.should == @project.project_dir + 'Sub/Baz.m'
+        @project.root_object.project_dir_path = 'Root'
+        file.real_path.should == @project.project_dir + 'Root/Sub/Baz.m'
+      end
+
+      it 'returns the real paths of the groups and of the file references' do
+        real_paths = @project.real_paths
+        real_paths[@project.main_group].should == @project.project_dir
+        real_paths[@group].should == @project.project_dir + 'Classes'
+        real_paths[@file].should == @project.project_dir + 'Classes/Foo.m'
+        real_paths.count.should == @project.groups.count + @project.files.count + 1
+        real_paths.each { |object, real_path| object.real_path.should.equal real_path }
+      end
+
+      it 'indexes the container item proxies' do
+        app = @project.new_target(:application, 'App', :ios)
+        library = @project.new_target(:static_library, 'Library', :ios)
+        app.add_dependency(library)
+        proxy = app.dependencies.first.target_proxy
+        index = @project.object_index
+        index.container_item_proxies_with_portal(@project.root_object.uuid).should == [proxy]
+        index.container_item_proxies_with_remote_global_id(library.uuid).should == [proxy]
+        proxy.remote_global_id_string = app.uuid
+        index.container_item_proxies_with_remote_global_id(library.uuid).should.be.empty
+        index.container_item_proxies_with_remote_global_id(app.uuid).should == [proxy]
+        @project.verify_object_index!
+      end
+
+      it 'is consistent for a project opened from a file' do
+        project = Xcodeproj::Project.open(fixture_path('Sample Project/Cocoa Application.xcodeproj'))
+        project.files.map(&:real_path).select(&:absolute?).each do |real_path|
+          project.reference_for_path(real_path).real_path.should == real_path
+        end
+        project.verify_object_index!
+      end
+    end
+  end
+end
@@ -45,6 +45,97 @@ module ProjectSpecs
         @list.count.should == before_count
       end
 
+      it 'can append multiple objects at once' do
+        files = %w(A.m B.m).map { |path| @project.new_file(path) }
+        before_count = @list.count
+        @list.concat(files).should.equal?(@list)
+        @list.count.should == before_count + 2
+        @list.last(2).should == files
+        files.each { |f| f.referrers.should == [@project.main_group] }
+      end
+
+      it 'can insert multiple objects at the given index' do
+        files = Array.new(2) { @project.new(PBXFileReference) }
+        first = @list.first
+        @list.insert_all(0, files)
+        @list.first(3).should == files + [first]
+        files.each { |f| f.referrers.should == [@project.main_group] }
+      end
+
+      it 'can replace its objects informing both the removed and the added objects' do
+        removed = @list.to_a
+        files = Array.new(2) { @project.new(PBXFileReference) }
+        @list.replace(files)
+        @list.to_a.should == files
+        removed.each { |object| object.referrers.should.not.include?(@project.main_group) }
+        files.each { |f| f.referrers.should == [@project.main_group] }
+      end
+
+      it 'leaves the list unchanged if the objects of a replacement are not valid' do
+        objects = @list.to_a
+        file = @project.new(PBXFileReference)
+        should.raise do
+          @list.replace([file, @project.new(XCBuildConfiguration)])
+        end.message.should.match(/Type checking error/)
+        @list.to_a.should == objects
+        file.referrers.should.be.empty
+        objects.each do |object|
+          object.referrers.should.include?(@project.main_group)
+          @project.objects_by_uuid[object.uuid].should.equal?(object)
+        end
+      end
+
+      it 'keeps the references of the objects which are part of both contents of a replacement' do
+        kept = @project.new_file('Kept.m')
+        removed = @list.to_a - [kept]
+        file = @project.new(PBXFileReference)
+        @project.objects_by_uuid[kept.uuid].should.equal?(kept)
+        @list.replace([file, kept])
+        @list.to_a.should == [file, kept]
+        kept.referrers.should == [@project.main_group]
+        @project.objects_by_uuid[kept.uuid].should.equal?(kept)
+        removed.each { |object| object.referrers.should.not.include?(@project.main_group) }
+        @project.verify_object_index!
+      end
+
+      it 'validates the objects added in bulk before adding any referrer' do
+        file = @project.new(PBXFileReference)
+        should.raise do
+          @list.concat([file, @project.new(XCBuildConfiguration)])
+        end.message.should.match(/Type checking error/)
+        file.referrers.should.be.empty
+      end
+
+      it 'marks the project as dirty when the order of the objects changes on sort' do
+        @list.sort! { |x, y| x.display_name <=> y.display_name }
+        sorted = @list.to_a
+        @project.instance_variable_set(:@dirty, false)
+        @list.sort! { |x, y| x.display_name <=> y.display_name }
+        @project.should.not.be.dirty
+        @list.sort! { |x, y| y.display_name <=> x.display_name }
+        @list.to_a.should == sorted.reverse
+        @project.should.be.dirty
+      end
+
+      it 'sorts by keys computed once per object in the same order as a comparison of the objects' do
+        %w(B.m a.h A.m b.h A.h).each { |path| @project.main_group.new_file(path) }
+        expected = @list.sort { |x, y| File.extname(x.display_name) <=> File.extname(y.display_name) }
+        computed = []
+        @list.sort_by_keys! { |object| computed << object; File.extname(object.display_name) }
+        @list.to_a.should == expected
+        computed.count.should == @list.count
+      end
+
+      it 'can delete multiple objects at once' do
+        files = %w(A.m B.m C.m).map { |path| @project.main_group.new_file(path) }
+        before_count = @list.count
+        @list.delete_objects(files.first(2)).should == files.first(2)
+        @list.count.should == before_count - 2
+        @list.should.include?(files.last)
+        files.first(2).each { |f| f.referrers.should.be.empty }
+        @project.objects_by_uuid[files.first.uuid].should.be.nil
+      end
+
       it 'can delete the object at the given index' do
         @list.clear
         f = @project.new(PBXFileReference)
@@ -1,4 +1,5 @@
 require File.expand_path('../../spec_helper', __FILE__)
+require 'stringio'
 
 module ProjectSpecs
   describe AbstractObject do
@@ -194,6 +195,72 @@ module ProjectSpecs
 
     #-------------------------------------------------------------------------#
 
+    describe 'Concerning the serialization cache' do
+      before do
+        @group = @project.new_group('Classes')
+        @file = @group.new_file('file.m')
+        @target = @project.new_target(:static_library, 'Pods', :ios)
+        @target.add_file_references([@file])
+        @project.to_ascii_plist
+      end
+
+      def serialize(project)
+        output = StringIO.new
+        Nanaimo::Writer::PBXProjWriter.new(project.to_ascii_plist, :pretty => true, :output => output, :strict => false).write
+        output.string
+      end
+
+      it 'reuses the representation of the objects which did not change' do
+        cached = @file.cached_ascii_plist
+        cached.should.not.be.nil
+        @project.to_ascii_plist
+        @file.cached_ascii_plist.should.equal?(cached)
+      end
+
+      it 'discards the representation of a modified object and of its referrers' do
+        configuration = @target.build_configurations.first
+        @file.name = 'other.m'
+        @file.cached_ascii_plist.should.be.nil
+        @group.cached_ascii_plist.should.be.nil
+        @target.source_build_phase.files.first.cached_ascii_plist.should.be.nil
+        @target.source_build_phase.cached_ascii_plist.should.be.nil
+        configuration.cached_ascii_plist.should.not.be.nil
+      end
+
+      it 'discards the representation of an object when its list changes' do
+        @group.new_file('other.m')
+        @group.cached_ascii_plist.should.be.nil
+        @file.cached_ascii_plist.should.not.be.nil
+      end
+
+      it 'detects the attributes modified in place' do
+        configuration = @target.build_configurations.first
+        configuration.build_settings['GCC_PREPROCESSOR_DEFINITIONS'] = 'FOO=1'
+        @project.refresh_ascii_plist_caches
+        configuration.cached_ascii_plist.should.be.nil
+        @target.build_configuration_list.cached_ascii_plist.should.be.nil
+      end
+
+      it 'keeps the representation of the attributes read but not modified' do
+        configuration = @target.build_configurations.first
+        configuration.build_settings['GCC_PREPROCESSOR_DEFINITIONS'].should.be.nil
+        @project.refresh_ascii_plist_caches
+        configuration.cached_ascii_plist.should.not.be.nil
+      end
+
+      it 'serializes a modified project as if nothing was cached' do
+        @file.name = 'other.m'
+        @group.new_file('new.m')
+        @target.build_configurations.first.build_settings['GCC_PREPROCESSOR_DEFINITIONS'] = 'FOO=1'
+        @project.sort
+        cached = serialize(@project)
+        @project.objects.each { |object| object.instance_variable_set(:@ascii_plist_cache, nil) }
+        cached.should == serialize(@project)
+      end
+    end
+
+    #-------------------------------------------------------------------------#
+
     describe 'Alternative representations' do
       before do
         @file = @project.new_file('Classes/file.m')
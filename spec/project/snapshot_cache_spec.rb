@@ -0,0 +1,73 @@
+require File.expand_path('../../spec_helper', __FILE__)
+
+module Xcodeproj
+  describe Project::SnapshotCache do
+    extend SpecHelper::TemporaryDirectory
+
+    before do
+      @project_path = fixture_path('Sample Project/Cocoa Application.xcodeproj')
+      @cache_dir = temporary_directory + 'Snapshots'
+      @events = []
+      @subscriber = Instrumentation.subscribe(/^project\.open\./) { |event| @events << event.name }
+    end
+
+    after do
+      Instrumentation.unsubscribe(@subscriber)
+    end
+
+    it 'stores a snapshot of a parsed project and loads it instead of parsing the file' do
+      parsed = Project.open(@project_path, :snapshot_cache => @cache_dir)
+      @events.should == %w(
+        project.open.snapshot.read project.open.parse project.open.snapshot.write
+        project.open.objects project.open.fixups
+      )
+      Dir[@cache_dir + "*#{Project::SnapshotCache::EXTENSION}"].count.should == 1
+
+      @events.clear
+      loaded = Project.open(@project_path, :snapshot_cache => @cache_dir)
+      @events.should == %w(project.open.snapshot.read project.open.objects project.open.fixups)
+      loaded.to_hash.should == parsed.to_hash
+    end
+
+    it 'returns the same contents as the parser with distinct strings' do
+      cache = Project::SnapshotCache.new(@cache_dir)
+      pbxproj_path = File.join(@project_path, 'project.pbxproj')
+      parsed = cache.fetch(pbxproj_path)
+      loaded = cache.fetch(pbxproj_path)
+      loaded.should == Plist.read_from_path(pbxproj_path)
+      loaded.should.not.be.identical_to parsed
+
+      build_files = loaded['objects'].values.select { |attributes| attributes['isa'] == 'PBXBuildFile' }
+      build_files.first['isa'].should.not.be.identical_to build_files.last['isa']
+      build_files.first['isa'] << 'Modified'
+      build_files.last['isa'].should == 'PBXBuildFile'
+    end
+
+    it 'ignores the snapshots which cannot be read' do
+      cache = Project::SnapshotCache.new(@cache_dir)
+      pbxproj_path = File.join(@project_path, 'project.pbxproj')
+      cache.fetch(pbxproj_path)
+      Dir[@cache_dir + '*'].each { |path| File.write(path, 'corrupted') }
+
+      @events.clear
+      cache.fetch(pbxproj_path).should == Plist.read_from_path(pbxproj_path)
+      @events.should.include 'project.open.parse'
+      cache.read(cache.digest(File.read(pbxproj_path))).should.not.be.nil
+    end
+
+    it 'opens the project if the cache directory cannot be written' do
+      FileUtils.mkdir_p(temporary_directory)
+      File.write(temporary_directory + 'Unwritable', '')
+      cache_dir = temporary_directory + 'Unwritable/Snapshots'
+      project = Project.open(@project_path, :snapshot_cache => cache_dir)
+      project.to_hash.should == Project.open(@project_path).to_hash
+      @events.should.include 'project.open.snapshot.write'
+      Project::SnapshotCache.new(cache_dir).write('digest', Plist.read_from_path(File.join(@project_path, 'project.pbxproj'))).should.be.false
+    end
+
+    it 'does not use the snapshots by default' do
+      Project.open(@project_path)
+      @events.should.not.include 'project.open.snapshot.read'
+    end
+  end
+end
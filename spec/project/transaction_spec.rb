@@ -0,0 +1,95 @@
+require File.expand_path('../../spec_helper', __FILE__)
+
+module ProjectSpecs
+  describe Xcodeproj::Project::Transaction do
+    before do
+      @group = @project.main_group.new_group('Classes', 'Classes')
+      @file = @group.new_file('Foo.m')
+      @target = @project.new_target(:static_library, 'Library', :ios)
+      @target.add_file_references([@file])
+      @project.save(@project.path)
+    end
+
+    def project_state
+      Marshal.dump([@project.to_hash, @project.objects.map { |object| [object.uuid, object.referrers.count] }.sort])
+    end
+
+    it 'commits the modifications performed in the block' do
+      result = @project.transaction do
+        @file.path = 'Bar.m'
+        @target.add_file_references([@group.new_file('Baz.m')])
+        :result
+      end
+      result.should == :result
+      @project.should.be.dirty
+      @group.files.map(&:path).should == %w(Bar.m Baz.m)
+      @group.find_file_by_path('Bar.m').should == @file
+      @target.source_build_phase.files_references.map(&:path).should == %w(Bar.m Baz.m)
+      @project.verify_object_index!
+    end
+
+    it 'defers the updates of the index until it is queried' do
+      @project.transaction do
+        file = @group.new_file('Baz.m')
+        @project.object_index.instance_variable_get(:@pending_updates).should.not.be.empty
+        @group.find_file_by_path('Baz.m').should == file
+      end
+      @project.verify_object_index!
+    end
+
+    it 'defers the type checking of the new values until commit' do
+      configuration = @project.build_configurations.first
+      state = project_state
+      should.raise do
+        @project.transaction do
+          @group.children << configuration
+          @group.children.last.should.equal configuration
+        end
+      end.message.should.match /Type checking error/
+      project_state.should == state
+    end
+
+    it 'restores the objects and removes the new ones if an exception is raised' do
+      state = project_state
+      build_settings = @target.build_configurations.first.build_settings
+      should.raise(ArgumentError) do
+        @project.transaction do
+          @file.path = 'Bar.m'
+          @group.name = 'Sources'
+          @target.add_file_references([@group.new_file('Baz.m')])
+          @target.build_configurations.first.build_settings['OTHER_LDFLAGS'] = '-ObjC'
+          @project.main_group.new_group('Other').children << @file
+          raise ArgumentError
+        end
+      end
+      project_state.should == state
+      build_settings.should.not.key 'OTHER_LDFLAGS'
+      @project.should.not.be.dirty
+      @group.files.should == [@file]
+      @file.real_path.should == @project.project_dir + 'Classes/Foo.m'
+      @project.verify_object_index!
+    end
+
+    it 'does not allow to save the project' do
+      should.raise do
+        @project.transaction do
+          @file.path = 'Bar.m'
+          @project.save
+        end
+      end.message.should.match /cannot be saved during a transaction/
+      @file.path.should == 'Foo.m'
+      @project.should.not.be.dirty
+    end
+
+    it 'joins a transaction in progress' do
+      state = project_state
+      should.raise(ArgumentError) do
+        @project.transaction do
+          @project.transaction { @group.new_file('Baz.m') }
+          raise ArgumentError
+        end
+      end
+      project_state.should == state
+    end
+  end
+end
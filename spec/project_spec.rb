@@ -204,6 +204,55 @@ module ProjectSpecs
         @project = Xcodeproj::Project.open(@path)
         @project.classes.should == {}
       end
+
+      describe 'lazily' do
+        before do
+          @lazy_project = Xcodeproj::Project.open(@path, :lazy => true)
+        end
+
+        it 'initializes only the objects which have been accessed' do
+          @lazy_project.should.be.lazily_loaded
+          @lazy_project.loaded_objects_by_uuid.count.should < @project.objects_by_uuid.count
+          @lazy_project.targets.map(&:name).should == @project.targets.map(&:name)
+          @lazy_project.should.be.lazily_loaded
+        end
+
+        it 'initializes the relationships of an object when first accessed' do
+          target = @lazy_project.targets.first
+          settings = target.build_configurations.map(&:build_settings)
+          settings.should == @project.targets.first.build_configurations.map(&:build_settings)
+        end
+
+        it 'initializes all the pending objects when the objects by UUID are accessed' do
+          @lazy_project.objects_by_uuid.keys.sort.should == @project.objects_by_uuid.keys.sort
+          @lazy_project.should.not.be.lazily_loaded
+        end
+
+        it 'returns the complete referrers of an object' do
+          file = @lazy_project.targets.first.source_build_phase.files.first.file_ref
+          expected = @project.objects_by_uuid[file.uuid]
+          file.referrers.map(&:uuid).sort.should == expected.referrers.map(&:uuid).sort
+          file.real_path.should == expected.real_path
+        end
+
+        it 'is not marked as dirty by the initialization of the objects' do
+          @lazy_project.targets.first.build_configurations
+          @lazy_project.objects
+          @lazy_project.should.not.be.dirty
+        end
+
+        it 'generates the same plist as a project opened eagerly' do
+          @lazy_project.targets.first.name
+          @lazy_project.to_hash.should == @project.to_hash
+        end
+
+        it 'generates new UUIDs which do not collide with the pending objects' do
+          @lazy_project.generate_available_uuid_list
+          @lazy_project.should.be.lazily_loaded
+          available = @lazy_project.instance_variable_get(:@available_uuids)
+          (available & @project.uuids).should.be.empty
+        end
+      end
     end
 
     #-------------------------------------------------------------------------#
@@ -290,6 +339,159 @@ module ProjectSpecs
         contents.should.include('わくわく')
         contents.should.include('Cédric')
       end
+
+      it 'writes the same contents as the ASCII plist writer of Nanaimo' do
+        Pathname.glob("#{fixture_path}/**/*.xcodeproj").each do |path|
+          next if path.to_s.include?('ProjectInMergeConflict/')
+          project = Xcodeproj::Project.open(path)
+          project.build_configurations.each do |config|
+            config.build_settings['OTHER_LDFLAGS'] = ['-ObjC', '$(inherited)']
+            config.build_settings['PRODUCT_NAME'] = 'わくわく'
+          end
+          expected = String.new
+          Nanaimo::Writer::PBXProjWriter.new(project.to_ascii_plist, :pretty => true, :output => expected, :strict => false).write
+          actual = String.new
+          Xcodeproj::Project::StreamingWriter.new(project, actual).write
+          actual.should == expected
+        end
+      end
+
+      it 'does not write the file if it already has the same contents' do
+        @project.save(@tmp_path)
+        project_file = @tmp_path + 'project.pbxproj'
+        File.utime(Time.at(0), Time.at(0), project_file)
+        @project.save(@tmp_path)
+        File.mtime(project_file).should == Time.at(0)
+
+        @project.main_group.new_file('Added.m')
+        @project.save(@tmp_path)
+        File.mtime(project_file).should.not == Time.at(0)
+        File.read(project_file).should.include 'Added.m'
+        Dir.children(@tmp_path).should == ['project.pbxproj']
+      end
+
+      it 'serializes the project once when it writes the file' do
+        Xcodeproj::Project::StreamingWriter.any_instance.expects(:write).once
+        @project.save(@tmp_path)
+      end
+    end
+
+    #-------------------------------------------------------------------------#
+
+    describe 'Content digest' do
+      before do
+        @path = fixture_path('Sample Project/Cocoa Application.xcodeproj')
+        @project = Xcodeproj::Project.open(@path)
+      end
+
+      it 'returns the same digest for projects with equal plists' do
+        other = Xcodeproj::Project.open(@path)
+        other.digest.should == @project.digest
+        other.should.eql @project
+
+        other.files.first.path = 'Renamed.m'
+        other.digest.should.not == @project.digest
+        other.should.not.eql @project
+        other.files.first.path = @project.files.first.path
+        other.should.eql @project
+      end
+
+      it 'updates the digests of a modified object and of its ancestors' do
+        file = @project.files.find { |f| f.parent.is_a?(Xcodeproj::Project::Object::PBXGroup) && f.parent != @project.main_group }
+        sibling = (@project.main_group.groups - [file.parent]).first
+        digests = [file, file.parent, @project.main_group, @project.root_object, sibling].map(&:digest)
+        file.name = 'Renamed'
+        new_digests = [file, file.parent, @project.main_group, @project.root_object, sibling].map(&:digest)
+        new_digests.first(4).zip(digests).each { |new_digest, digest| new_digest.should.not == digest }
+        new_digests.last.should == digests.last
+      end
+
+      it 'detects the values modified in place' do
+        digest = @project.digest
+        @project.build_configurations.first.build_settings['OTHER_LDFLAGS'] = '-ObjC'
+        @project.digest.should.not == digest
+        @project.build_configurations.first.build_settings.delete('OTHER_LDFLAGS')
+        @project.digest.should == digest
+      end
+
+      it 'restores the digest if a transaction is rolled back' do
+        digest = @project.digest
+        should.raise(RuntimeError) do
+          @project.transaction do
+            @project.main_group.new_file('Added.m')
+            @project.digest.should.not == digest
+            raise 'Rollback'
+          end
+        end
+        @project.digest.should == digest
+      end
+
+      it 'updates the digest if the UUIDs change' do
+        digest = @project.digest
+        @project.predictabilize_uuids
+        @project.digest.should.not == digest
+        other = Xcodeproj::Project.open(@path)
+        other.predictabilize_uuids
+        @project.digest.should == other.digest
+      end
+
+      it 'digests only the modified objects and their ancestors' do
+        @project.digest
+        file = @project.files.first
+        file.path = 'Renamed.m'
+        discarded = @project.objects.select { |object| object.instance_variable_get(:@digest).nil? }
+        discarded.should.include file
+        discarded.should.include @project.root_object
+        discarded.count.should < @project.objects.count / 2
+      end
+
+      it 'digests the targets referenced by the exception sets of their synchronized groups' do
+        target = @project.targets.first
+        group = @project.new(Xcodeproj::Project::Object::PBXFileSystemSynchronizedRootGroup)
+        group.path = 'Synchronized'
+        @project.main_group.children << group
+        target.file_system_synchronized_groups << group
+        exception_set = @project.new(Xcodeproj::Project::Object::PBXFileSystemSynchronizedBuildFileExceptionSet)
+        exception_set.target = target
+        group.exceptions << exception_set
+        digest = @project.digest
+        exception_set.membership_exceptions = ['Excluded.m']
+        @project.digest.should.not == digest
+      end
+    end
+
+    #-------------------------------------------------------------------------#
+
+    describe 'Removing objects' do
+      before do
+        @target = @project.new_target(:static_library, 'Pods', :ios)
+        @group = @project.main_group.new_group('Classes')
+        @files = %w(A.m B.m C.m).map { |path| @group.new_file(path) }
+        @target.add_file_references(@files)
+      end
+
+      it 'removes multiple objects and their build files' do
+        build_files = @files.first(2).map { |file| @target.source_build_phase.build_file(file) }
+        @project.remove_objects(@files.first(2))
+        @group.children.should == [@files.last]
+        @target.source_build_phase.files_references.should == [@files.last]
+        (@files.first(2) + build_files).each do |object|
+          @project.objects_by_uuid[object.uuid].should.be.nil
+          object.referrers.should.be.empty
+        end
+        @project.verify_object_index!
+      end
+
+      it 'produces the same project as removing the objects one by one' do
+        path = fixture_path('Sample Project/Cocoa Application.xcodeproj')
+        bulk = Xcodeproj::Project.open(path)
+        serial = Xcodeproj::Project.open(path)
+        uuids = bulk.files.select { |file| file.path.to_s.end_with?('.m') }.map(&:uuid)
+        uuids.should.not.be.empty
+        bulk.remove_objects(uuids.map { |uuid| bulk.objects_by_uuid[uuid] })
+        uuids.each { |uuid| serial.objects_by_uuid[uuid].remove_from_project }
+        bulk.to_hash.should == serial.to_hash
+      end
     end
 
     #-------------------------------------------------------------------------#
@@ -339,6 +541,28 @@ module ProjectSpecs
         @project.uuids.should.not.include?(obj.uuid)
         @project.generated_uuids.should.include?(obj.uuid)
       end
+
+      it 'generates reproducible UUIDs from a seed' do
+        build = lambda do |seed|
+          project = Xcodeproj::Project.new(@project.path, false, Xcodeproj::Constants::DEFAULT_OBJECT_VERSION, :uuid_seed => seed)
+          project.new_target(:application, 'App', :ios)
+          project
+        end
+        project = build.call('Seed')
+        project.uuid_seed.should == 'Seed'
+        project.to_hash.should == build.call('Seed').to_hash
+        project.uuids.sort.should.not == build.call('Other').uuids.sort
+      end
+
+      it 'skips the seeded UUIDs which are already used by the project' do
+        path = SpecHelper.temporary_directory + 'Seeded.xcodeproj'
+        project = Xcodeproj::Project.new(path, false, Xcodeproj::Constants::DEFAULT_OBJECT_VERSION, :uuid_seed => 'Seed')
+        project.save
+        reopened = Xcodeproj::Project.open(path, :uuid_seed => 'Seed')
+        reopened.new_target(:application, 'App', :ios)
+        reopened.uuids.count.should > project.uuids.count
+        (reopened.generated_uuids.to_a & project.uuids).should.be.empty
+      end
     end
 
     #-------------------------------------------------------------------------#
@@ -556,6 +780,16 @@ module ProjectSpecs
             it 'does not have duplicate UUIDS' do
               open_project[].uuids.size.should == open_project[].uuids.uniq.size
             end
+
+            it 'computes the path components from the tree hash of the objects' do
+              project = Xcodeproj::Project.open(path)
+              generator = Xcodeproj::Project::UUIDGenerator.new([project])
+              project.objects.each do |object|
+                expected = generator.send(:tree_hash_to_path, object.to_tree_hash)
+                expected << object.hierarchy_path.to_s if object.respond_to?(:hierarchy_path)
+                generator.send(:path_component_for_object, object).should == expected
+              end
+            end
           end
         end
       end
@@ -634,6 +868,24 @@ module ProjectSpecs
         @project.targets.map(&:name).should == %w(A B)
         @project.build_configurations.map(&:name).should == %w(A B Debug Release)
       end
+
+      it 'only sorts the objects changed since the last sort when sorting incrementally' do
+        changed = @project.new_group('Changed')
+        untouched = @project.new_group('Untouched')
+        files = %w(A.m B.m C.m).map { |path| changed.new_file(path) }
+        %w(A.m B.m).each { |path| untouched.new_file(path) }
+        @project.sort(:incremental => true)
+        changed.children.map(&:display_name).should == %w(A.m B.m C.m)
+
+        files.first.name = 'D.m'
+        untouched.children.reverse!
+        @project.sort(:incremental => true)
+        changed.children.map(&:display_name).should == %w(B.m C.m D.m)
+        untouched.children.map(&:display_name).should == %w(B.m A.m)
+
+        @project.sort(:incremental => true, :groups_position => :above)
+        untouched.children.map(&:display_name).should == %w(A.m B.m)
+      end
     end
 
     #-------------------------------------------------------------------------#
@@ -670,6 +922,19 @@ module ProjectSpecs
           scheme.build_action.entries.count.should == 2
         end
 
+        it 'saves the schemes of all the targets as yielded' do
+          sut = Xcodeproj::Project.new(SpecHelper.temporary_directory + 'Pods.xcodeproj')
+          names = (1..20).map { |index| "Target#{index}" }
+          names.each { |name| sut.new_target(:application, name, :ios) }
+          schemes = {}
+          sut.recreate_user_schemes { |scheme, target| schemes[target.name] = scheme }
+          schemes_dir = sut.path + "xcuserdata/#{ENV['USER']}.xcuserdatad/xcschemes"
+          schemes.keys.should == names
+          schemes.each do |name, scheme|
+            File.read(schemes_dir + "#{name}.xcscheme").should == scheme.to_s
+          end
+        end
+
         it 'can hide the recreated user schemes' do
           sut = Xcodeproj::Project.new(SpecHelper.temporary_directory + 'Pods.xcodeproj')
           sut.new_target(:application, 'Xcode', :ios)
@@ -773,6 +1038,13 @@ module ProjectSpecs
                                         'WatchOS 2 App',
                                         'Today']
       end
+
+      it 'identifies hosts of targets referenced only through a target proxy' do
+        today_extension = target_for_target_name('Today')
+        dependency = target_for_target_name('Extensions').dependencies.find { |d| d.target.equal?(today_extension) }
+        dependency.target = nil
+        @project.host_targets_for_embedded_target(today_extension).map(&:name).should == ['Extensions']
+      end
     end
 
     describe 'Remote embedded target relationships' do
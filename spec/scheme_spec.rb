@@ -306,6 +306,12 @@ module ProjectSpecs
         actual.should == expected
       end
 
+      it 'writes the schemes created by Xcode byte for byte' do
+        Dir.glob(fixture_path('**', '*.xcscheme')).each do |scheme_path|
+          Xcodeproj::XCScheme.new(scheme_path).to_s.should == File.read(scheme_path)
+        end
+      end
+
       it 'saves in place when initialized from file' do
         scheme_dir = 'SharedSchemes/SharedSchemes.xcodeproj/xcshareddata/xcschemes/'
         scheme_name = 'SharedSchemes.xcscheme'
@@ -334,7 +340,7 @@ module ProjectSpecs
         File.exist?(scheme_file).should.be.true
 
         FileUtils.rm_r scheme_file
-        @scheme.save!
+        @scheme.save!.should == @scheme.to_s.bytesize
 
         File.exist?(scheme_file).should.be.true
         File.read(scheme_file).should == @scheme.to_s
@@ -0,0 +1,49 @@
+require File.expand_path('../../spec_helper', __FILE__)
+
+module Xcodeproj
+  describe Workspace::Index do
+    extend SpecHelper::TemporaryDirectory
+
+    before do
+      FileUtils.cp_r(fixture_path('WorkspaceSchemes'), temporary_directory)
+      @root = temporary_directory + 'WorkspaceSchemes'
+      @workspace_path = (@root + 'WorkspaceSchemes.xcworkspace').to_s
+      @app_project_path = (@root + 'WorkspaceSchemesApp/WorkspaceSchemesApp.xcodeproj').to_s
+      @workspace = Workspace.new_from_xcworkspace(@workspace_path)
+    end
+
+    it 'finds the project which defines a target, a product or a scheme' do
+      index = @workspace.index
+      index.project_for_target('WorkspaceSchemesApp').should == @app_project_path
+      index.project_for_target_uuid('B83E0CD92061E2CB00DEE246').should == @app_project_path
+      index.project_for_product('WorkspaceSchemesApp').should == @app_project_path
+      index.project_for_product('WorkspaceSchemesApp.app').should == @app_project_path
+      index.project_for_target('Unknown').should.be.nil
+    end
+
+    it 'finds the schemes like the workspace' do
+      index = @workspace.index
+      @workspace.schemes.each do |name, path|
+        index.project_for_scheme(name).should == path
+      end
+    end
+
+    it 'persists the index next to the workspace' do
+      @workspace.index
+      File.exist?(File.join(@workspace_path, 'xcuserdata', Workspace::Index::FILE_NAME)).should.be.true
+      Plist.expects(:read_from_path).never
+      workspace = Workspace.new_from_xcworkspace(@workspace_path)
+      workspace.index.project_for_target('WorkspaceSchemesApp').should == @app_project_path
+    end
+
+    it 'reads again the projects which changed' do
+      @workspace.index
+      pbxproj_path = File.join(@app_project_path, 'project.pbxproj')
+      File.write(pbxproj_path, File.read(pbxproj_path).gsub('name = WorkspaceSchemesApp;', 'name = RenamedApp;'))
+      File.utime(Time.now + 10, Time.now + 10, pbxproj_path)
+      index = Workspace.new_from_xcworkspace(@workspace_path).index
+      index.project_for_target('RenamedApp').should == @app_project_path
+      index.project_for_target('WorkspaceSchemesApp').should.be.nil
+    end
+  end
+end
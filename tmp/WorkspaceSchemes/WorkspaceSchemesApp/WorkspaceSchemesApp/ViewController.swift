@@ -0,0 +1,25 @@
+//
+//  ViewController.swift
+//  WorkspaceSchemesApp
+//
+//  Created by Louis Franco on 3/20/18.
+//  Copyright © 2018 Trello. All rights reserved.
+//
+
+import UIKit
+
+class ViewController: UIViewController {
+
+    override func viewDidLoad() {
+        super.viewDidLoad()
+        // Do any additional setup after loading the view, typically from a nib.
+    }
+
+    override func didReceiveMemoryWarning() {
+        super.didReceiveMemoryWarning()
+        // Dispose of any resources that can be recreated.
+    }
+
+
+}
+
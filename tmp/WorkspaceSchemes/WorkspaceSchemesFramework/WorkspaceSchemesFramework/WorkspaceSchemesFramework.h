@@ -0,0 +1,19 @@
+//
+//  WorkspaceSchemesFramework.h
+//  WorkspaceSchemesFramework
+//
+//  Created by Louis Franco on 3/20/18.
+//  Copyright © 2018 Trello. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+//! Project version number for WorkspaceSchemesFramework.
+FOUNDATION_EXPORT double WorkspaceSchemesFrameworkVersionNumber;
+
+//! Project version string for WorkspaceSchemesFramework.
+FOUNDATION_EXPORT const unsigned char WorkspaceSchemesFrameworkVersionString[];
+
+// In this header, you should import all the public headers of your framework using statements like #import <WorkspaceSchemesFramework/PublicHeader.h>
+
+